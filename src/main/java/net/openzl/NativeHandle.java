@@ -0,0 +1,107 @@
+package net.openzl;
+
+import java.lang.ref.Cleaner;
+import java.lang.ref.Reference;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.LongConsumer;
+
+/**
+ * Reference-counted owner of a native compressor or decompressor pointer.
+ *
+ * Every native call brackets its use of the pointer with acquire() / release(). close()
+ * only marks the handle closed; the pointer is destroyed by whichever of close() and the
+ * last release() comes second, so a close racing with calls on other threads can never
+ * free memory that is still in use. The state is a single int (users << 1 | closed bit),
+ * so acquire and release are one CAS / getAndAdd each.
+ *
+ * If the owner becomes unreachable without close(), a Cleaner destroys the pointer. The
+ * JIT may treat the owner as dead as soon as a method has loaded the handle and pointer,
+ * even with a native call still running on it. The handle therefore keeps the owner, and
+ * release() ends with a reachability fence on it, so the Cleaner cannot run while any user
+ * holds the pointer.
+ */
+final class NativeHandle {
+    
+    private static final Cleaner CLEANER = Cleaner.create();
+    private static final int CLOSED = 1;
+    private static final int USER = 2;
+    
+    private final Object owner;
+    private final long ptr;
+    private final String name;
+    private final AtomicInteger state = new AtomicInteger();
+    private final Cleaner.Cleanable cleanable;
+    
+    NativeHandle(Object owner, long ptr, LongConsumer destroy, String name) {
+        this.owner = owner;
+        this.ptr = ptr;
+        this.name = name;
+        this.cleanable = CLEANER.register(owner, new Destroy(ptr, destroy));
+    }
+    
+    /**
+     * Registers one more user and returns the pointer, or throws if the handle is closed.
+     */
+    long acquire() {
+        while (true) {
+            int current = state.get();
+            if ((current & CLOSED) != 0) {
+                throw new IllegalStateException(name + " has been closed");
+            }
+            if (state.compareAndSet(current, current + USER)) {
+                return ptr;
+            }
+        }
+    }
+    
+    void release() {
+        if (state.addAndGet(-USER) == CLOSED) {
+            cleanable.clean();
+        }
+        Reference.reachabilityFence(owner);
+    }
+    
+    /**
+     * Marks the handle closed; the pointer is destroyed now if nobody holds it, otherwise by
+     * the last release(). Idempotent.
+     */
+    void close() {
+        while (true) {
+            int current = state.get();
+            if ((current & CLOSED) != 0) {
+                return;
+            }
+            if (state.compareAndSet(current, current | CLOSED)) {
+                if (current == 0) {
+                    cleanable.clean();
+                }
+                return;
+            }
+        }
+    }
+    
+    boolean isClosed() {
+        return (state.get() & CLOSED) != 0;
+    }
+    
+    /**
+     * Cleaner action; holds only the pointer so the owner can still become unreachable.
+     * Cleanable.clean() runs it at most once.
+     */
+    private static final class Destroy implements Runnable {
+        private final long ptr;
+        private final LongConsumer destroy;
+        
+        Destroy(long ptr, LongConsumer destroy) {
+            this.ptr = ptr;
+            this.destroy = destroy;
+        }
+        
+        @Override
+        public void run() {
+            if (ptr != 0) {
+                destroy.accept(ptr);
+            }
+        }
+    }
+}
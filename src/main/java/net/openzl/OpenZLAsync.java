@@ -0,0 +1,323 @@
+package net.openzl;
+
+import java.lang.foreign.MemorySegment;
+import java.util.Objects;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.locks.Condition;
+import java.util.concurrent.locks.ReentrantLock;
+import java.util.function.Function;
+
+/**
+ * Runs compression and decompression on a dedicated, fixed-size executor and hands the
+ * results back as CompletableFutures, so event-loop threads never sit in native calls.
+ *
+ * Each worker thread owns one compressor per graph and one decompressor, created on first
+ * use and closed when the worker exits. Backpressure is by bytes rather than by task
+ * count: a compression task is charged its source bytes and a decompression task the size
+ * its frame decodes to, and submissions block while the charges of queued and running
+ * tasks would exceed maxInFlightBytes. The try* methods never block; over budget they
+ * return a future already failed with RejectedExecutionException. A single request larger
+ * than the whole budget is admitted once nothing else is in flight. Source arrays must not
+ * be modified until their future completes.
+ */
+public final class OpenZLAsync implements AutoCloseable {
+    
+    public static final long DEFAULT_MAX_IN_FLIGHT_BYTES = 256L * 1024 * 1024;
+    
+    private static final AtomicInteger INSTANCES = new AtomicInteger();
+    
+    private final CompressionGraph graph;
+    private final long maxInFlightBytes;
+    private final ThreadPoolExecutor executor;
+    private final ReentrantLock budgetLock = new ReentrantLock();
+    private final Condition budgetFreed = budgetLock.newCondition();
+    private long inFlightBytes;
+    private volatile boolean closed = false;
+    
+    public OpenZLAsync() {
+        this(CompressionGraph.ZSTD, Runtime.getRuntime().availableProcessors(), DEFAULT_MAX_IN_FLIGHT_BYTES);
+    }
+    
+    public OpenZLAsync(CompressionGraph graph, int threads, long maxInFlightBytes) {
+        if (graph == null) {
+            throw new IllegalArgumentException("Compression graph cannot be null");
+        }
+        if (threads <= 0) {
+            throw new IllegalArgumentException("Thread count must be positive");
+        }
+        if (maxInFlightBytes <= 0) {
+            throw new IllegalArgumentException("In-flight byte limit must be positive");
+        }
+        this.graph = graph;
+        this.maxInFlightBytes = maxInFlightBytes;
+        
+        String prefix = "openzl-async-" + INSTANCES.incrementAndGet() + "-";
+        AtomicInteger workers = new AtomicInteger();
+        this.executor = new ThreadPoolExecutor(threads, threads, 0L, TimeUnit.MILLISECONDS,
+                new LinkedBlockingQueue<>(), task -> new Worker(task, prefix + workers.incrementAndGet()));
+    }
+    
+    public CompletableFuture<byte[]> compressAsync(byte[] src) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        return compressAsync(graph, src, 0, src.length);
+    }
+    
+    public CompletableFuture<byte[]> compressAsync(byte[] src, int srcOff, int srcLen) {
+        return compressAsync(graph, src, srcOff, srcLen);
+    }
+    
+    public CompletableFuture<byte[]> compressAsync(CompressionGraph graph, byte[] src, int srcOff, int srcLen) {
+        if (graph == null) {
+            throw new IllegalArgumentException("Compression graph cannot be null");
+        }
+        checkRange(src, srcOff, srcLen);
+        return submit(srcLen, true, worker -> worker.compressor(graph).compress(src, srcOff, srcLen));
+    }
+    
+    public CompletableFuture<byte[]> tryCompressAsync(byte[] src) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        return tryCompressAsync(graph, src, 0, src.length);
+    }
+    
+    public CompletableFuture<byte[]> tryCompressAsync(byte[] src, int srcOff, int srcLen) {
+        return tryCompressAsync(graph, src, srcOff, srcLen);
+    }
+    
+    /**
+     * Like compressAsync, but fails the returned future instead of waiting when the
+     * in-flight budget is full.
+     */
+    public CompletableFuture<byte[]> tryCompressAsync(CompressionGraph graph, byte[] src, int srcOff, int srcLen) {
+        if (graph == null) {
+            throw new IllegalArgumentException("Compression graph cannot be null");
+        }
+        checkRange(src, srcOff, srcLen);
+        return submit(srcLen, false, worker -> worker.compressor(graph).compress(src, srcOff, srcLen));
+    }
+    
+    public CompletableFuture<byte[]> decompressAsync(byte[] src) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        return decompressAsync(src, 0, src.length);
+    }
+    
+    public CompletableFuture<byte[]> decompressAsync(byte[] src, int srcOff, int srcLen) {
+        checkRange(src, srcOff, srcLen);
+        return submit(decompressedSize(src, srcOff, srcLen), true,
+                worker -> worker.decompressor().decompress(src, srcOff, srcLen));
+    }
+    
+    public CompletableFuture<byte[]> tryDecompressAsync(byte[] src) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        return tryDecompressAsync(src, 0, src.length);
+    }
+    
+    /**
+     * Like decompressAsync, but fails the returned future instead of waiting when the
+     * in-flight budget is full.
+     */
+    public CompletableFuture<byte[]> tryDecompressAsync(byte[] src, int srcOff, int srcLen) {
+        checkRange(src, srcOff, srcLen);
+        return submit(decompressedSize(src, srcOff, srcLen), false,
+                worker -> worker.decompressor().decompress(src, srcOff, srcLen));
+    }
+    
+    /**
+     * Bytes charged to all tasks that have been admitted and not yet finished.
+     */
+    public long getInFlightBytes() {
+        budgetLock.lock();
+        try {
+            return inFlightBytes;
+        } finally {
+            budgetLock.unlock();
+        }
+    }
+    
+    public long getMaxInFlightBytes() {
+        return maxInFlightBytes;
+    }
+    
+    public CompressionGraph getGraph() {
+        return graph;
+    }
+    
+    /**
+     * Stops accepting work, lets queued tasks finish and waits for the workers to exit,
+     * which closes their compressors and decompressors.
+     */
+    @Override
+    public void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        
+        budgetLock.lock();
+        try {
+            budgetFreed.signalAll();
+        } finally {
+            budgetLock.unlock();
+        }
+        
+        executor.shutdown();
+        try {
+            while (!executor.awaitTermination(1, TimeUnit.SECONDS)) {
+                // Keep waiting for in-flight native calls.
+            }
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+    }
+    
+    private <T> CompletableFuture<T> submit(long bytes, boolean wait, Function<Worker, T> action) {
+        if (closed) {
+            throw new IllegalStateException("OpenZLAsync has been closed");
+        }
+        try {
+            if (!acquire(bytes, wait)) {
+                return CompletableFuture.failedFuture(new RejectedExecutionException(
+                        "In-flight byte limit reached: " + bytes + " more would exceed " + maxInFlightBytes));
+            }
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return CompletableFuture.failedFuture(e);
+        } catch (RejectedExecutionException e) {
+            return CompletableFuture.failedFuture(e);
+        }
+        
+        CompletableFuture<T> future = new CompletableFuture<>();
+        try {
+            executor.execute(() -> {
+                T result = null;
+                Throwable failure = null;
+                try {
+                    result = action.apply((Worker) Thread.currentThread());
+                } catch (Throwable t) {
+                    failure = t;
+                } finally {
+                    release(bytes);
+                }
+                if (failure != null) {
+                    future.completeExceptionally(failure);
+                } else {
+                    future.complete(result);
+                }
+            });
+        } catch (RejectedExecutionException e) {
+            release(bytes);
+            future.completeExceptionally(e);
+        }
+        return future;
+    }
+    
+    /**
+     * Charges bytes to the budget, waiting for room if wait is set; otherwise returns false
+     * when there is none.
+     */
+    private boolean acquire(long bytes, boolean wait) throws InterruptedException {
+        budgetLock.lockInterruptibly();
+        try {
+            while (inFlightBytes > 0 && inFlightBytes + bytes > maxInFlightBytes) {
+                if (closed) {
+                    throw new RejectedExecutionException("OpenZLAsync has been closed");
+                }
+                if (!wait) {
+                    return false;
+                }
+                budgetFreed.await();
+            }
+            inFlightBytes += bytes;
+            return true;
+        } finally {
+            budgetLock.unlock();
+        }
+    }
+    
+    private void release(long bytes) {
+        budgetLock.lock();
+        try {
+            inFlightBytes -= bytes;
+            budgetFreed.signalAll();
+        } finally {
+            budgetLock.unlock();
+        }
+    }
+    
+    /**
+     * The frame's decompressed size from its header, read in place with
+     * ZL_getDecompressedSize. A source that is not a valid frame, or a JVM without the FFM
+     * binding, is charged its own length; the decode then reports any error.
+     */
+    private static long decompressedSize(byte[] src, int srcOff, int srcLen) {
+        try {
+            return OpenZLFFM.decompressedSize(MemorySegment.ofArray(src).asSlice(srcOff, srcLen));
+        } catch (OpenZLException | LinkageError e) {
+            return srcLen;
+        }
+    }
+    
+    private static void checkRange(byte[] src, int srcOff, int srcLen) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        Objects.checkFromIndexSize(srcOff, srcLen, src.length);
+    }
+    
+    /**
+     * Executor thread that owns its compressors and decompressor for its whole life.
+     */
+    private static final class Worker extends Thread {
+        private final OpenZLCompressor[] compressors = new OpenZLCompressor[CompressionGraph.values().length];
+        private OpenZLDecompressor decompressor;
+        
+        Worker(Runnable task, String name) {
+            super(task, name);
+            setDaemon(true);
+        }
+        
+        OpenZLCompressor compressor(CompressionGraph graph) {
+            OpenZLCompressor compressor = compressors[graph.ordinal()];
+            if (compressor == null) {
+                compressor = new OpenZLCompressor(graph);
+                compressors[graph.ordinal()] = compressor;
+            }
+            return compressor;
+        }
+        
+        OpenZLDecompressor decompressor() {
+            if (decompressor == null) {
+                decompressor = new OpenZLDecompressor();
+            }
+            return decompressor;
+        }
+        
+        @Override
+        public void run() {
+            try {
+                super.run();
+            } finally {
+                for (OpenZLCompressor compressor : compressors) {
+                    if (compressor != null) {
+                        compressor.close();
+                    }
+                }
+                if (decompressor != null) {
+                    decompressor.close();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,20 @@
+package net.openzl;
+
+import java.util.Locale;
+
+public enum OpenZLBackend {
+    
+    JNI,
+    FFM;
+    
+    static OpenZLBackend fromProperty(String value) {
+        if (value == null || value.isEmpty()) {
+            return JNI;
+        }
+        try {
+            return valueOf(value.trim().toUpperCase(Locale.ROOT));
+        } catch (IllegalArgumentException e) {
+            throw new IllegalArgumentException("Invalid OpenZL backend: " + value);
+        }
+    }
+}
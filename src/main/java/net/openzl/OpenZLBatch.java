@@ -0,0 +1,66 @@
+package net.openzl;
+
+import java.util.Arrays;
+
+/**
+ * Independently compressed frames stored back to back in one array, as produced by
+ * OpenZLCompressor.compressBatch. Frame i spans [getOffset(i), getOffset(i + 1)) of
+ * getData(), so offsets holds size() + 1 entries. The arrays are shared, not copied.
+ */
+public final class OpenZLBatch {
+    
+    private final byte[] data;
+    private final int[] offsets;
+    
+    public OpenZLBatch(byte[] data, int[] offsets) {
+        if (data == null || offsets == null) {
+            throw new IllegalArgumentException("Data and offsets cannot be null");
+        }
+        if (offsets.length == 0 || offsets[0] < 0 || offsets[offsets.length - 1] > data.length) {
+            throw new IndexOutOfBoundsException("Invalid batch offsets");
+        }
+        for (int i = 1; i < offsets.length; i++) {
+            if (offsets[i] < offsets[i - 1]) {
+                throw new IndexOutOfBoundsException("Batch offsets must not decrease");
+            }
+        }
+        this.data = data;
+        this.offsets = offsets;
+    }
+    
+    public int size() {
+        return offsets.length - 1;
+    }
+    
+    public byte[] getData() {
+        return data;
+    }
+    
+    public int[] getOffsets() {
+        return offsets;
+    }
+    
+    public int getOffset(int index) {
+        return offsets[index];
+    }
+    
+    public int getLength(int index) {
+        return offsets[index + 1] - offsets[index];
+    }
+    
+    /**
+     * Returns a copy of frame index.
+     */
+    public byte[] getFrame(int index) {
+        return Arrays.copyOfRange(data, offsets[index], offsets[index + 1]);
+    }
+    
+    public int getTotalSize() {
+        return offsets[offsets.length - 1] - offsets[0];
+    }
+    
+    @Override
+    public String toString() {
+        return String.format("OpenZLBatch{frames=%d, totalSize=%d}", size(), getTotalSize());
+    }
+}
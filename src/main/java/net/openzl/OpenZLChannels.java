@@ -0,0 +1,197 @@
+package net.openzl;
+
+import java.io.EOFException;
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.channels.WritableByteChannel;
+
+/**
+ * Compresses files into block containers (see OpenZLFrameFormat) on channels without
+ * copying payload bytes through the Java heap. The input file is memory-mapped in windows
+ * of about 64 MB and handed to native code by address, one block at a time. Frames are
+ * written into a single direct buffer that the output channel drains, so RSS beyond the
+ * page cache stays at one window plus one frame.
+ *
+ * Contexts come from OpenZLPool.shared(). Both directions process the input channel from
+ * its current position to its end, then leave the position at the end. The output channel
+ * is not closed.
+ */
+public final class OpenZLChannels {
+    
+    static final long WINDOW_SIZE = 64L * 1024 * 1024;
+    
+    private OpenZLChannels() {
+    }
+    
+    public static long compress(FileChannel in, WritableByteChannel out) throws IOException {
+        return compress(in, out, CompressionGraph.ZSTD, OpenZLFrameFormat.DEFAULT_BLOCK_SIZE);
+    }
+    
+    /**
+     * Compresses the rest of in into an indexed block container on out. Returns the number
+     * of bytes written.
+     */
+    public static long compress(FileChannel in, WritableByteChannel out, CompressionGraph graph, int blockSize)
+            throws IOException {
+        if (in == null || out == null) {
+            throw new IllegalArgumentException("Source and destination channels cannot be null");
+        }
+        if (graph == null) {
+            throw new IllegalArgumentException("Compression graph cannot be null");
+        }
+        OpenZLFrameFormat.checkBlockSize(blockSize);
+        
+        long start = in.position();
+        long size = in.size();
+        long blocks = Math.max(0, (size - start + blockSize - 1) / blockSize);
+        if (blocks > Integer.MAX_VALUE - 8) {
+            throw new OpenZLException("Too many blocks for one container; use a larger block size");
+        }
+        int count = (int) blocks;
+        long[] frameOffsets = new long[count];
+        int[] compressedSizes = new int[count];
+        int[] rawSizes = new int[count];
+        
+        ByteBuffer frame = ByteBuffer.allocateDirect(OpenZLFrameFormat.BLOCK_HEADER_SIZE
+                + OpenZLCompressor.maxCompressedLength(blockSize));
+        MemorySegment frameSegment = MemorySegment.ofBuffer(frame);
+        OpenZLFrameFormat.writeHeader(frameSegment, 0, OpenZLFrameFormat.FLAG_INDEXED, blockSize);
+        frame.limit(OpenZLFrameFormat.HEADER_SIZE);
+        writeFully(out, frame);
+        long position = OpenZLFrameFormat.HEADER_SIZE;
+        
+        OpenZLCompressor compressor = OpenZLPool.shared().borrowCompressor(graph);
+        try (Window window = new Window(in, size)) {
+            MemorySegment payload = frameSegment.asSlice(OpenZLFrameFormat.BLOCK_HEADER_SIZE);
+            for (int i = 0; i < count; i++) {
+                long offset = start + (long) i * blockSize;
+                int rawSize = (int) Math.min(blockSize, size - offset);
+                int compressed = (int) compressor.compress(window.slice(offset, rawSize), payload);
+                OpenZLFrameFormat.writeBlockHeader(frameSegment, 0, compressed, rawSize);
+                
+                frameOffsets[i] = position + OpenZLFrameFormat.BLOCK_HEADER_SIZE;
+                compressedSizes[i] = compressed;
+                rawSizes[i] = rawSize;
+                frame.clear().limit(OpenZLFrameFormat.BLOCK_HEADER_SIZE + compressed);
+                writeFully(out, frame);
+                position += OpenZLFrameFormat.BLOCK_HEADER_SIZE + compressed;
+            }
+        } finally {
+            OpenZLPool.shared().release(compressor);
+        }
+        
+        ByteBuffer footer = ByteBuffer.allocateDirect(OpenZLFrameFormat.END_MARKER_SIZE
+                + OpenZLFrameFormat.indexSize(count));
+        OpenZLFrameFormat.writeFooter(MemorySegment.ofBuffer(footer), 0, position,
+                new OpenZLFrameFormat.BlockTable(blockSize, count, frameOffsets, compressedSizes, rawSizes, 0));
+        writeFully(out, footer);
+        in.position(size);
+        return position + footer.capacity();
+    }
+    
+    /**
+     * Decompresses the block container that starts at in's position onto out, walking the
+     * block headers in order. Returns the number of bytes written.
+     */
+    public static long decompress(FileChannel in, WritableByteChannel out) throws IOException {
+        if (in == null || out == null) {
+            throw new IllegalArgumentException("Source and destination channels cannot be null");
+        }
+        
+        long start = in.position();
+        long size = in.size();
+        long written = 0;
+        OpenZLDecompressor decompressor = OpenZLPool.shared().borrowDecompressor();
+        try (Window window = new Window(in, size)) {
+            MemorySegment header = window.slice(start, OpenZLFrameFormat.HEADER_SIZE);
+            if (!OpenZLFrameFormat.isContainer(header)) {
+                throw new OpenZLException("Not an OpenZL block container");
+            }
+            int version = header.get(OpenZLFrameFormat.INT, 4) & 0xFF;
+            if (version != OpenZLFrameFormat.VERSION) {
+                throw new OpenZLException("Unsupported block container version: " + version);
+            }
+            int blockSize = header.get(OpenZLFrameFormat.INT, 8);
+            if (blockSize < OpenZLFrameFormat.MIN_BLOCK_SIZE || blockSize > OpenZLFrameFormat.MAX_BLOCK_SIZE) {
+                throw new OpenZLException("Corrupt OpenZL block container: invalid block size " + blockSize);
+            }
+            
+            ByteBuffer block = ByteBuffer.allocateDirect(blockSize);
+            MemorySegment blockSegment = MemorySegment.ofBuffer(block);
+            long pos = start + OpenZLFrameFormat.HEADER_SIZE;
+            while (true) {
+                int compressedSize = window.slice(pos, OpenZLFrameFormat.END_MARKER_SIZE).get(OpenZLFrameFormat.INT, 0);
+                if (compressedSize == 0) {
+                    break;
+                }
+                int rawSize = window.slice(pos, OpenZLFrameFormat.BLOCK_HEADER_SIZE).get(OpenZLFrameFormat.INT, 4);
+                if (compressedSize < 0 || rawSize < 0 || rawSize > blockSize) {
+                    throw new OpenZLException("Corrupt OpenZL block container: block sizes out of bounds");
+                }
+                
+                MemorySegment frame = window.slice(pos + OpenZLFrameFormat.BLOCK_HEADER_SIZE, compressedSize);
+                long decoded = decompressor.decompress(frame, blockSegment.asSlice(0, rawSize));
+                if (decoded != rawSize) {
+                    throw new OpenZLException("Block decompressed to " + decoded + " bytes, expected " + rawSize);
+                }
+                block.clear().limit(rawSize);
+                writeFully(out, block);
+                written += rawSize;
+                pos += OpenZLFrameFormat.BLOCK_HEADER_SIZE + compressedSize;
+            }
+        } finally {
+            OpenZLPool.shared().release(decompressor);
+        }
+        in.position(size);
+        return written;
+    }
+    
+    private static void writeFully(WritableByteChannel out, ByteBuffer buffer) throws IOException {
+        while (buffer.hasRemaining()) {
+            out.write(buffer);
+        }
+    }
+    
+    /**
+     * Read-only mapping of one window of a file. slice() remaps, unmapping the previous
+     * window, whenever the requested range is not inside the current one.
+     */
+    private static final class Window implements AutoCloseable {
+        private final FileChannel channel;
+        private final long size;
+        private Arena arena;
+        private MemorySegment segment;
+        private long start;
+        
+        Window(FileChannel channel, long size) {
+            this.channel = channel;
+            this.size = size;
+        }
+        
+        MemorySegment slice(long offset, long length) throws IOException {
+            if (offset < 0 || length > size - offset) {
+                throw new EOFException("Truncated OpenZL block container");
+            }
+            if (segment == null || offset < start || offset + length > start + segment.byteSize()) {
+                close();
+                arena = Arena.ofConfined();
+                start = offset;
+                segment = channel.map(FileChannel.MapMode.READ_ONLY, offset,
+                        Math.min(size - offset, Math.max(WINDOW_SIZE, length)), arena);
+            }
+            return segment.asSlice(offset - start, length);
+        }
+        
+        @Override
+        public void close() {
+            if (arena != null) {
+                arena.close();
+                arena = null;
+                segment = null;
+            }
+        }
+    }
+}
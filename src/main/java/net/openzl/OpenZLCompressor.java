@@ -1,19 +1,31 @@
 package net.openzl;
 
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
 import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Objects;
 
 public final class OpenZLCompressor implements AutoCloseable {
     
     private final CompressionGraph graph;
+    private final OpenZLBackend backend;
     private final long nativePtr;
-    private volatile boolean closed = false;
+    private final NativeHandle handle;
     
     OpenZLCompressor(CompressionGraph graph) {
         this.graph = graph;
+        this.backend = OpenZLFactory.getBackend();
         this.nativePtr = OpenZLJNI.createCompressor(graph.getId());
         if (this.nativePtr == 0) {
             throw new OpenZLException("Failed to create compressor");
         }
+        this.handle = new NativeHandle(this, nativePtr, OpenZLJNI::destroyCompressor, "Compressor");
     }
     
     public byte[] compress(byte[] src) {
@@ -21,127 +33,375 @@ public final class OpenZLCompressor implements AutoCloseable {
     }
     
     public byte[] compress(byte[] src, int srcOff, int srcLen) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source array cannot be null");
-        }
-        if (srcOff < 0 || srcLen < 0 || srcOff + srcLen > src.length) {
-            throw new IndexOutOfBoundsException("Invalid offset or length");
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source array cannot be null");
+            }
+            Objects.checkFromIndexSize(srcOff, srcLen, src.length);
+            if (OpenZLOffload.shouldOffload(srcLen)) {
+                return OpenZLOffload.call(() -> compress(src, srcOff, srcLen));
+            }
+            
+            if (backend == OpenZLBackend.FFM) {
+                return OpenZLFFM.compress(nativePtr, MemorySegment.ofArray(src).asSlice(srcOff, srcLen));
+            }
+            return OpenZLJNI.compressSerial(nativePtr, src, srcOff, srcLen);
+        } finally {
+            handle.release();
         }
-        
-        return OpenZLJNI.compressSerial(nativePtr, src, srcOff, srcLen);
     }
     
     public int compress(byte[] src, int srcOff, int srcLen, byte[] dest, int destOff, int maxDestLen) {
-        if (src == null || dest == null) {
-            throw new IllegalArgumentException("Source and destination cannot be null");
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination cannot be null");
+            }
+            checkRange(src, srcOff, srcLen);
+            checkRange(dest, destOff, maxDestLen);
+            if (OpenZLOffload.shouldOffload(srcLen)) {
+                return OpenZLOffload.call(() -> compress(src, srcOff, srcLen, dest, destOff, maxDestLen));
+            }
+            if (backend == OpenZLBackend.FFM) {
+                return (int) OpenZLFFM.compress(nativePtr, MemorySegment.ofArray(src).asSlice(srcOff, srcLen),
+                        MemorySegment.ofArray(dest).asSlice(destOff, maxDestLen));
+            }
+            return OpenZLJNI.compressSerialToBuffer(nativePtr, src, srcOff, srcLen, dest, destOff, maxDestLen);
+        } finally {
+            handle.release();
         }
-        checkRange(src, srcOff, srcLen);
-        checkRange(dest, destOff, maxDestLen);
-        return OpenZLJNI.compressSerialToBuffer(nativePtr, src, srcOff, srcLen, dest, destOff, maxDestLen);
     }
     
     public byte[] compress(ByteBuffer src) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source buffer cannot be null");
-        }
-        
-        if (src.hasArray()) {
-            return compress(src.array(), src.arrayOffset() + src.position(), src.remaining());
-        } else {
-            byte[] data = new byte[src.remaining()];
-            src.get(data);
-            return compress(data);
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source buffer cannot be null");
+            }
+            
+            if (src.hasArray()) {
+                return compress(src.array(), src.arrayOffset() + src.position(), src.remaining());
+            } else {
+                byte[] data = new byte[src.remaining()];
+                src.get(data);
+                return compress(data);
+            }
+        } finally {
+            handle.release();
         }
     }
     
     public int compress(ByteBuffer src, ByteBuffer dest) {
-        checkNotClosed();
-        if (src == null || dest == null) {
-            throw new IllegalArgumentException("Source and destination buffers cannot be null");
-        }
-        
-        byte[] srcArray;
-        int srcOff = 0;
-        int srcLen = src.remaining();
-        
-        if (src.hasArray()) {
-            srcArray = src.array();
-            srcOff = src.arrayOffset() + src.position();
-        } else {
-            srcArray = new byte[srcLen];
-            src.get(srcArray);
-        }
-        
-        byte[] destArray;
-        int destOff = 0;
-        int maxDestLen = dest.remaining();
-        
-        if (dest.hasArray()) {
-            destArray = dest.array();
-            destOff = dest.arrayOffset() + dest.position();
-        } else {
-            destArray = new byte[maxDestLen];
-        }
-        
-        int written = compress(srcArray, srcOff, srcLen, destArray, destOff, maxDestLen);
-        
-        if (!dest.hasArray()) {
-            dest.put(destArray, 0, written);
-        } else {
-            dest.position(dest.position() + written);
-        }
-        
-        return written;
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination buffers cannot be null");
+            }
+            if (dest.isReadOnly()) {
+                throw new ReadOnlyBufferException();
+            }
+            if (OpenZLOffload.shouldOffload(src.remaining())) {
+                return OpenZLOffload.call(() -> compress(src, dest));
+            }
+            
+            if (backend == OpenZLBackend.FFM) {
+                int written = (int) OpenZLFFM.compress(nativePtr, MemorySegment.ofBuffer(src), MemorySegment.ofBuffer(dest));
+                src.position(src.limit());
+                dest.position(dest.position() + written);
+                return written;
+            }
+            
+            if (src.isDirect() && dest.isDirect()) {
+                int written = OpenZLJNI.compressDirect(nativePtr, src, src.position(), src.remaining(),
+                        dest, dest.position(), dest.remaining());
+                src.position(src.limit());
+                dest.position(dest.position() + written);
+                return written;
+            }
+            
+            byte[] srcArray;
+            int srcOff = 0;
+            int srcLen = src.remaining();
+            
+            if (src.hasArray()) {
+                srcArray = src.array();
+                srcOff = src.arrayOffset() + src.position();
+            } else {
+                srcArray = new byte[srcLen];
+                src.get(srcArray);
+            }
+            
+            byte[] destArray;
+            int destOff = 0;
+            int maxDestLen = dest.remaining();
+            
+            if (dest.hasArray()) {
+                destArray = dest.array();
+                destOff = dest.arrayOffset() + dest.position();
+            } else {
+                destArray = new byte[maxDestLen];
+            }
+            
+            int written = compress(srcArray, srcOff, srcLen, destArray, destOff, maxDestLen);
+            src.position(src.limit());
+            
+            if (!dest.hasArray()) {
+                dest.put(destArray, 0, written);
+            } else {
+                dest.position(dest.position() + written);
+            }
+            
+            return written;
+        } finally {
+            handle.release();
+        }
     }
     
-    public byte[] compressNumeric(byte[] data, int elementSize, int elementCount) {
-        if (data == null) {
-            throw new IllegalArgumentException("Data cannot be null");
+    /**
+     * Compresses every array into its own frame with a single native call that reuses this
+     * compressor's context, returning the frames back to back in one OpenZLBatch. Batches
+     * always run on the JNI backend.
+     */
+    public OpenZLBatch compressBatch(byte[][] srcs) {
+        handle.acquire();
+        try {
+            if (srcs == null) {
+                throw new IllegalArgumentException("Source arrays cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload(totalLength(srcs))) {
+                return OpenZLOffload.call(() -> compressBatch(srcs));
+            }
+            int[] offsets = new int[srcs.length + 1];
+            byte[] data = OpenZLJNI.compressBatch(nativePtr, srcs, null, null, offsets);
+            return new OpenZLBatch(data, offsets);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    /**
+     * Compresses the remaining bytes of every buffer into its own frame with a single native
+     * call; direct buffers are read in place. Each buffer's position is advanced to its limit.
+     */
+    public OpenZLBatch compressBatch(ByteBuffer... srcs) {
+        handle.acquire();
+        try {
+            if (srcs == null) {
+                throw new IllegalArgumentException("Source buffers cannot be null");
+            }
+            
+            Object[] items = new Object[srcs.length];
+            int[] offs = new int[srcs.length];
+            int[] lens = new int[srcs.length];
+            for (int i = 0; i < srcs.length; i++) {
+                ByteBuffer src = srcs[i];
+                if (src == null) {
+                    throw new IllegalArgumentException("Source buffer cannot be null");
+                }
+                lens[i] = src.remaining();
+                if (src.isDirect()) {
+                    items[i] = src;
+                    offs[i] = src.position();
+                } else if (src.hasArray()) {
+                    items[i] = src.array();
+                    offs[i] = src.arrayOffset() + src.position();
+                } else {
+                    byte[] copy = new byte[lens[i]];
+                    src.duplicate().get(copy);
+                    items[i] = copy;
+                }
+            }
+            long total = 0;
+            for (int len : lens) {
+                total += len;
+            }
+            if (OpenZLOffload.shouldOffload(total)) {
+                return OpenZLOffload.call(() -> compressBatch(srcs));
+            }
+            
+            int[] offsets = new int[srcs.length + 1];
+            byte[] data = OpenZLJNI.compressBatch(nativePtr, items, offs, lens, offsets);
+            for (ByteBuffer src : srcs) {
+                src.position(src.limit());
+            }
+            return new OpenZLBatch(data, offsets);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public long compress(MemorySegment src, MemorySegment dest) {
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination segments cannot be null");
+            }
+            return OpenZLFFM.compress(nativePtr, src, dest);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public MemorySegment compress(MemorySegment src, Arena arena) {
+        handle.acquire();
+        try {
+            if (src == null || arena == null) {
+                throw new IllegalArgumentException("Source segment and arena cannot be null");
+            }
+            MemorySegment dest = arena.allocate(OpenZLFFM.compressBound(src.byteSize()));
+            long written = OpenZLFFM.compress(nativePtr, src, dest);
+            return dest.asSlice(0, written);
+        } finally {
+            handle.release();
         }
-        if (elementSize <= 0 || elementCount <= 0) {
-            throw new IllegalArgumentException("Element size and count must be positive");
+    }
+    
+    /**
+     * Compresses a whole file into a single frame in one call, regardless of its size.
+     * Both files are memory-mapped; dest is created or truncated, and deleted again if the
+     * call fails. src and dest must be different files. Returns the frame size.
+     */
+    public long compress(Path src, Path dest) throws IOException {
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination paths cannot be null");
+            }
+            OpenZLFiles.checkDistinct(src, dest);
+            if (OpenZLOffload.shouldOffload(Files.size(src))) {
+                return OpenZLOffload.callIO(() -> compress(src, dest));
+            }
+            try (FileChannel in = FileChannel.open(src, StandardOpenOption.READ)) {
+                FileChannel out = FileChannel.open(dest, StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING,
+                        StandardOpenOption.READ, StandardOpenOption.WRITE);
+                try (out) {
+                    long written;
+                    try (Arena arena = Arena.ofConfined()) {
+                        MemorySegment input = in.map(FileChannel.MapMode.READ_ONLY, 0, in.size(), arena);
+                        MemorySegment output = out.map(FileChannel.MapMode.READ_WRITE, 0,
+                                OpenZLFFM.compressBound(input.byteSize()), arena);
+                        written = OpenZLFFM.compress(nativePtr, input, output);
+                    }
+                    out.truncate(written);
+                    return written;
+                } catch (IOException | RuntimeException e) {
+                    OpenZLFiles.discard(dest, e);
+                    throw e;
+                }
+            }
+        } finally {
+            handle.release();
         }
-        if (data.length != elementSize * elementCount) {
-            throw new IllegalArgumentException("Data length doesn't match element size * count");
+    }
+    
+    public long compressNumeric(MemorySegment src, int elementSize, MemorySegment dest) {
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination segments cannot be null");
+            }
+            checkElementSize(elementSize);
+            return OpenZLFFM.compressNumeric(nativePtr, src, elementSize, dest);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public byte[] compressNumeric(byte[] data, int elementSize, int elementCount) {
+        handle.acquire();
+        try {
+            if (data == null) {
+                throw new IllegalArgumentException("Data cannot be null");
+            }
+            if (elementSize <= 0 || elementCount <= 0) {
+                throw new IllegalArgumentException("Element size and count must be positive");
+            }
+            checkElementSize(elementSize);
+            if (data.length != (long) elementSize * elementCount) {
+                throw new IllegalArgumentException("Data length doesn't match element size * count");
+            }
+            if (OpenZLOffload.shouldOffload(data.length)) {
+                return OpenZLOffload.call(() -> compressNumeric(data, elementSize, elementCount));
+            }
+            return OpenZLJNI.compressNumeric(nativePtr, data, elementSize, elementCount);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.compressNumeric(nativePtr, data, elementSize, elementCount);
     }
     
     public byte[] compressInts(int[] data) {
-        checkNotClosed();
-        if (data == null) {
-            throw new IllegalArgumentException("Data array cannot be null");
+        handle.acquire();
+        try {
+            if (data == null) {
+                throw new IllegalArgumentException("Data array cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload((long) data.length * Integer.BYTES)) {
+                return OpenZLOffload.call(() -> compressInts(data));
+            }
+            return OpenZLJNI.compressNumericInts(nativePtr, data);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.compressNumericInts(nativePtr, data);
     }
     
     public byte[] compressLongs(long[] data) {
-        checkNotClosed();
-        if (data == null) {
-            throw new IllegalArgumentException("Data array cannot be null");
+        handle.acquire();
+        try {
+            if (data == null) {
+                throw new IllegalArgumentException("Data array cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload((long) data.length * Long.BYTES)) {
+                return OpenZLOffload.call(() -> compressLongs(data));
+            }
+            return OpenZLJNI.compressNumericLongs(nativePtr, data);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.compressNumericLongs(nativePtr, data);
     }
     
     public byte[] compressFloats(float[] data) {
-        checkNotClosed();
-        if (data == null) {
-            throw new IllegalArgumentException("Data array cannot be null");
+        handle.acquire();
+        try {
+            if (data == null) {
+                throw new IllegalArgumentException("Data array cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload((long) data.length * Float.BYTES)) {
+                return OpenZLOffload.call(() -> compressFloats(data));
+            }
+            return OpenZLJNI.compressNumericFloats(nativePtr, data);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.compressNumericFloats(nativePtr, data);
     }
     
     public byte[] compressDoubles(double[] data) {
-        checkNotClosed();
-        if (data == null) {
-            throw new IllegalArgumentException("Data array cannot be null");
+        handle.acquire();
+        try {
+            if (data == null) {
+                throw new IllegalArgumentException("Data array cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload((long) data.length * Double.BYTES)) {
+                return OpenZLOffload.call(() -> compressDoubles(data));
+            }
+            return OpenZLJNI.compressNumericDoubles(nativePtr, data);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.compressNumericDoubles(nativePtr, data);
     }
     
     public static int maxCompressedLength(int srcLen) {
+        long bound = maxCompressedLength((long) srcLen);
+        if (bound > Integer.MAX_VALUE) {
+            throw new OpenZLException("Compressed bound exceeds the maximum array size; use maxCompressedLength(long)");
+        }
+        return (int) bound;
+    }
+    
+    public static long maxCompressedLength(long srcLen) {
+        if (srcLen < 0) {
+            throw new IllegalArgumentException("Source length cannot be negative");
+        }
         return OpenZLJNI.compressBound(srcLen);
     }
     
@@ -149,26 +409,40 @@ public final class OpenZLCompressor implements AutoCloseable {
         return graph;
     }
     
+    OpenZLBackend getBackend() {
+        return backend;
+    }
+    
+    boolean isClosed() {
+        return handle.isClosed();
+    }
+    
+    /**
+     * Closes the compressor. Safe while other threads are still compressing with it: the
+     * native context is freed once the last of those calls returns.
+     */
     public void close() {
-        if (!closed) {
-            closed = true;
-            if (nativePtr != 0) {
-                OpenZLJNI.destroyCompressor(nativePtr);
+        handle.close();
+    }
+    
+    
+    private static long totalLength(byte[][] srcs) {
+        long total = 0;
+        for (byte[] src : srcs) {
+            if (src != null) {
+                total += src.length;
             }
         }
+        return total;
     }
     
-    private void checkNotClosed() {
-        if (closed) {
-            throw new IllegalStateException("Compressor has been closed");
+    private static void checkElementSize(int elementSize) {
+        if (elementSize != 1 && elementSize != 2 && elementSize != 4 && elementSize != 8) {
+            throw new IllegalArgumentException("Element size must be 1, 2, 4 or 8 bytes");
         }
     }
     
-
-    
     private static void checkRange(byte[] buf, int off, int len) {
-        if (off < 0 || len < 0 || off + len > buf.length) {
-            throw new IndexOutOfBoundsException("Invalid range: offset=" + off + ", length=" + len + ", buffer length=" + buf.length);
-        }
+        Objects.checkFromIndexSize(off, len, buf.length);
     }
 }
\ No newline at end of file
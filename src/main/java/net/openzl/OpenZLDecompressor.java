@@ -1,17 +1,29 @@
 package net.openzl;
 
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
 import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Objects;
 
 public final class OpenZLDecompressor implements AutoCloseable {
     
+    private final OpenZLBackend backend;
     private final long nativePtr;
-    private volatile boolean closed = false;
+    private final NativeHandle handle;
     
     OpenZLDecompressor() {
+        this.backend = OpenZLFactory.getBackend();
         this.nativePtr = OpenZLJNI.createDecompressor();
         if (this.nativePtr == 0) {
             throw new OpenZLException("Failed to create decompressor");
         }
+        this.handle = new NativeHandle(this, nativePtr, OpenZLJNI::destroyDecompressor, "Decompressor");
     }
     
     public byte[] decompress(byte[] src) {
@@ -19,122 +31,372 @@ public final class OpenZLDecompressor implements AutoCloseable {
     }
     
     public byte[] decompress(byte[] src, int srcOff, int srcLen) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source data cannot be null");
-        }
-        if (srcOff < 0 || srcLen < 0 || srcOff + srcLen > src.length) {
-            throw new IndexOutOfBoundsException("Invalid offset or length");
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source data cannot be null");
+            }
+            Objects.checkFromIndexSize(srcOff, srcLen, src.length);
+            if (OpenZLOffload.shouldOffload(srcLen)) {
+                return OpenZLOffload.call(() -> decompress(src, srcOff, srcLen));
+            }
+            if (backend == OpenZLBackend.FFM) {
+                return OpenZLFFM.decompress(nativePtr, MemorySegment.ofArray(src).asSlice(srcOff, srcLen));
+            }
+            return OpenZLJNI.decompressSerial(nativePtr, src, srcOff, srcLen);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.decompressSerial(nativePtr, src, srcOff, srcLen);
     }
     
     public int decompress(byte[] src, int srcOff, int srcLen, byte[] dest, int destOff, int maxDestLen) {
-        checkNotClosed();
-        if (src == null || dest == null) {
-            throw new IllegalArgumentException("Source and destination cannot be null");
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination cannot be null");
+            }
+            checkRange(src, srcOff, srcLen);
+            checkRange(dest, destOff, maxDestLen);
+            if (OpenZLOffload.shouldOffload(maxDestLen)) {
+                return OpenZLOffload.call(() -> decompress(src, srcOff, srcLen, dest, destOff, maxDestLen));
+            }
+            if (backend == OpenZLBackend.FFM) {
+                return (int) OpenZLFFM.decompress(nativePtr, MemorySegment.ofArray(src).asSlice(srcOff, srcLen),
+                        MemorySegment.ofArray(dest).asSlice(destOff, maxDestLen));
+            }
+            return OpenZLJNI.decompressSerialToBuffer(nativePtr, src, srcOff, srcLen, dest, destOff, maxDestLen);
+        } finally {
+            handle.release();
         }
-        checkRange(src, srcOff, srcLen);
-        checkRange(dest, destOff, maxDestLen);
-        return OpenZLJNI.decompressSerialToBuffer(nativePtr, src, srcOff, srcLen, dest, destOff, maxDestLen);
     }
     
     public byte[] decompress(ByteBuffer src) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source buffer cannot be null");
-        }
-        
-        if (src.hasArray()) {
-            return decompress(src.array(), src.arrayOffset() + src.position(), src.remaining());
-        } else {
-            byte[] data = new byte[src.remaining()];
-            src.get(data);
-            return decompress(data);
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source buffer cannot be null");
+            }
+            
+            if (src.hasArray()) {
+                return decompress(src.array(), src.arrayOffset() + src.position(), src.remaining());
+            } else {
+                byte[] data = new byte[src.remaining()];
+                src.get(data);
+                return decompress(data);
+            }
+        } finally {
+            handle.release();
         }
     }
     
     public int decompress(ByteBuffer src, ByteBuffer dest) {
-        checkNotClosed();
-        if (src == null || dest == null) {
-            throw new IllegalArgumentException("Source and destination buffers cannot be null");
-        }
-        
-        byte[] srcArray;
-        int srcOff = 0;
-        int srcLen = src.remaining();
-        
-        if (src.hasArray()) {
-            srcArray = src.array();
-            srcOff = src.arrayOffset() + src.position();
-        } else {
-            srcArray = new byte[srcLen];
-            src.get(srcArray);
-        }
-        
-        byte[] destArray;
-        int destOff = 0;
-        int maxDestLen = dest.remaining();
-        
-        if (dest.hasArray()) {
-            destArray = dest.array();
-            destOff = dest.arrayOffset() + dest.position();
-        } else {
-            destArray = new byte[maxDestLen];
-        }
-        
-        int written = decompress(srcArray, srcOff, srcLen, destArray, destOff, maxDestLen);
-        
-        if (!dest.hasArray()) {
-            dest.put(destArray, 0, written);
-        } else {
-            dest.position(dest.position() + written);
-        }
-        
-        return written;
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination buffers cannot be null");
+            }
+            if (dest.isReadOnly()) {
+                throw new ReadOnlyBufferException();
+            }
+            if (OpenZLOffload.shouldOffload(dest.remaining())) {
+                return OpenZLOffload.call(() -> decompress(src, dest));
+            }
+            
+            if (backend == OpenZLBackend.FFM) {
+                int written = (int) OpenZLFFM.decompress(nativePtr, MemorySegment.ofBuffer(src), MemorySegment.ofBuffer(dest));
+                src.position(src.limit());
+                dest.position(dest.position() + written);
+                return written;
+            }
+            
+            if (src.isDirect() && dest.isDirect()) {
+                int written = OpenZLJNI.decompressDirect(nativePtr, src, src.position(), src.remaining(),
+                        dest, dest.position(), dest.remaining());
+                src.position(src.limit());
+                dest.position(dest.position() + written);
+                return written;
+            }
+            
+            byte[] srcArray;
+            int srcOff = 0;
+            int srcLen = src.remaining();
+            
+            if (src.hasArray()) {
+                srcArray = src.array();
+                srcOff = src.arrayOffset() + src.position();
+            } else {
+                srcArray = new byte[srcLen];
+                src.get(srcArray);
+            }
+            
+            byte[] destArray;
+            int destOff = 0;
+            int maxDestLen = dest.remaining();
+            
+            if (dest.hasArray()) {
+                destArray = dest.array();
+                destOff = dest.arrayOffset() + dest.position();
+            } else {
+                destArray = new byte[maxDestLen];
+            }
+            
+            int written = decompress(srcArray, srcOff, srcLen, destArray, destOff, maxDestLen);
+            src.position(src.limit());
+            
+            if (!dest.hasArray()) {
+                dest.put(destArray, 0, written);
+            } else {
+                dest.position(dest.position() + written);
+            }
+            
+            return written;
+        } finally {
+            handle.release();
+        }
     }
     
-    public byte[] decompressNumeric(byte[] src, int elementSize, int expectedCount) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source data cannot be null");
+    /**
+     * Decompresses every frame of a batch with a single native call that reuses this
+     * decompressor's context. Batches always run on the JNI backend.
+     */
+    public byte[][] decompressBatch(OpenZLBatch batch) {
+        if (batch == null) {
+            throw new IllegalArgumentException("Batch cannot be null");
         }
-        if (elementSize <= 0 || expectedCount <= 0) {
-            throw new IllegalArgumentException("Element size and expected count must be positive");
+        return decompressBatch(batch.getData(), batch.getOffsets());
+    }
+    
+    /**
+     * Decompresses frames stored back to back in src, frame i spanning
+     * [offsets[i], offsets[i + 1]).
+     */
+    public byte[][] decompressBatch(byte[] src, int[] offsets) {
+        handle.acquire();
+        try {
+            if (src == null || offsets == null) {
+                throw new IllegalArgumentException("Source and offsets cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload(src.length)) {
+                return OpenZLOffload.call(() -> decompressBatch(src, offsets));
+            }
+            return OpenZLJNI.decompressBatch(nativePtr, src, offsets);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public long decompress(MemorySegment src, MemorySegment dest) {
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination segments cannot be null");
+            }
+            return OpenZLFFM.decompress(nativePtr, src, dest);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public MemorySegment decompress(MemorySegment src, Arena arena) {
+        handle.acquire();
+        try {
+            if (src == null || arena == null) {
+                throw new IllegalArgumentException("Source segment and arena cannot be null");
+            }
+            MemorySegment dest = arena.allocate(OpenZLFFM.decompressedSize(src));
+            long written = OpenZLFFM.decompress(nativePtr, src, dest);
+            return dest.asSlice(0, written);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    /**
+     * Decompresses a single-frame file written by OpenZLCompressor.compress(Path, Path),
+     * regardless of its size. Both files are memory-mapped; dest is created or truncated,
+     * and deleted again if the call fails. src and dest must be different files. Returns the
+     * decompressed size.
+     */
+    public long decompress(Path src, Path dest) throws IOException {
+        handle.acquire();
+        try {
+            if (src == null || dest == null) {
+                throw new IllegalArgumentException("Source and destination paths cannot be null");
+            }
+            OpenZLFiles.checkDistinct(src, dest);
+            if (OpenZLOffload.shouldOffload(Files.size(src))) {
+                return OpenZLOffload.callIO(() -> decompress(src, dest));
+            }
+            try (FileChannel in = FileChannel.open(src, StandardOpenOption.READ)) {
+                FileChannel out = FileChannel.open(dest, StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING,
+                        StandardOpenOption.READ, StandardOpenOption.WRITE);
+                try (out) {
+                    long written;
+                    try (Arena arena = Arena.ofConfined()) {
+                        MemorySegment input = in.map(FileChannel.MapMode.READ_ONLY, 0, in.size(), arena);
+                        MemorySegment output = out.map(FileChannel.MapMode.READ_WRITE, 0,
+                                OpenZLFFM.decompressedSize(input), arena);
+                        written = OpenZLFFM.decompress(nativePtr, input, output);
+                    }
+                    out.truncate(written);
+                    return written;
+                } catch (IOException | RuntimeException e) {
+                    OpenZLFiles.discard(dest, e);
+                    throw e;
+                }
+            }
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public byte[] decompressNumeric(byte[] src, int elementSize, int expectedCount) {
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source data cannot be null");
+            }
+            if (elementSize <= 0 || expectedCount <= 0) {
+                throw new IllegalArgumentException("Element size and expected count must be positive");
+            }
+            if (elementSize != 1 && elementSize != 2 && elementSize != 4 && elementSize != 8) {
+                throw new IllegalArgumentException("Element size must be 1, 2, 4 or 8 bytes");
+            }
+            if (OpenZLOffload.shouldOffload((long) elementSize * expectedCount)) {
+                return OpenZLOffload.call(() -> decompressNumeric(src, elementSize, expectedCount));
+            }
+            return OpenZLJNI.decompressNumeric(nativePtr, src, elementSize, expectedCount);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.decompressNumeric(nativePtr, src, elementSize, expectedCount);
     }
     
     public int[] decompressNumericInts(byte[] src) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source data cannot be null");
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source data cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload(src.length)) {
+                return OpenZLOffload.call(() -> decompressNumericInts(src));
+            }
+            return OpenZLJNI.decompressNumericInts(nativePtr, src);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.decompressNumericInts(nativePtr, src);
     }
     
     public long[] decompressNumericLongs(byte[] src) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source data cannot be null");
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source data cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload(src.length)) {
+                return OpenZLOffload.call(() -> decompressNumericLongs(src));
+            }
+            return OpenZLJNI.decompressNumericLongs(nativePtr, src);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.decompressNumericLongs(nativePtr, src);
     }
     
     public float[] decompressNumericFloats(byte[] src) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source data cannot be null");
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source data cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload(src.length)) {
+                return OpenZLOffload.call(() -> decompressNumericFloats(src));
+            }
+            return OpenZLJNI.decompressNumericFloats(nativePtr, src);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.decompressNumericFloats(nativePtr, src);
     }
     
     public double[] decompressNumericDoubles(byte[] src) {
-        checkNotClosed();
-        if (src == null) {
-            throw new IllegalArgumentException("Source data cannot be null");
+        handle.acquire();
+        try {
+            if (src == null) {
+                throw new IllegalArgumentException("Source data cannot be null");
+            }
+            if (OpenZLOffload.shouldOffload(src.length)) {
+                return OpenZLOffload.call(() -> decompressNumericDoubles(src));
+            }
+            return OpenZLJNI.decompressNumericDoubles(nativePtr, src);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public int decompressInto(byte[] src, int[] dest, int destOff) {
+        return decompressInto(src, 0, src == null ? 0 : src.length, dest, destOff);
+    }
+    
+    public int decompressInto(byte[] src, int srcOff, int srcLen, int[] dest, int destOff) {
+        handle.acquire();
+        try {
+            checkIntoArgs(src, srcOff, srcLen, dest, destOff, dest == null ? 0 : dest.length);
+            if (OpenZLOffload.shouldOffload((long) (dest.length - destOff) * Integer.BYTES)) {
+                return OpenZLOffload.call(() -> decompressInto(src, srcOff, srcLen, dest, destOff));
+            }
+            return OpenZLJNI.decompressNumericIntsInto(nativePtr, src, srcOff, srcLen, dest, destOff);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public int decompressInto(byte[] src, long[] dest, int destOff) {
+        return decompressInto(src, 0, src == null ? 0 : src.length, dest, destOff);
+    }
+    
+    public int decompressInto(byte[] src, int srcOff, int srcLen, long[] dest, int destOff) {
+        handle.acquire();
+        try {
+            checkIntoArgs(src, srcOff, srcLen, dest, destOff, dest == null ? 0 : dest.length);
+            if (OpenZLOffload.shouldOffload((long) (dest.length - destOff) * Long.BYTES)) {
+                return OpenZLOffload.call(() -> decompressInto(src, srcOff, srcLen, dest, destOff));
+            }
+            return OpenZLJNI.decompressNumericLongsInto(nativePtr, src, srcOff, srcLen, dest, destOff);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public int decompressInto(byte[] src, float[] dest, int destOff) {
+        return decompressInto(src, 0, src == null ? 0 : src.length, dest, destOff);
+    }
+    
+    public int decompressInto(byte[] src, int srcOff, int srcLen, float[] dest, int destOff) {
+        handle.acquire();
+        try {
+            checkIntoArgs(src, srcOff, srcLen, dest, destOff, dest == null ? 0 : dest.length);
+            if (OpenZLOffload.shouldOffload((long) (dest.length - destOff) * Float.BYTES)) {
+                return OpenZLOffload.call(() -> decompressInto(src, srcOff, srcLen, dest, destOff));
+            }
+            return OpenZLJNI.decompressNumericFloatsInto(nativePtr, src, srcOff, srcLen, dest, destOff);
+        } finally {
+            handle.release();
+        }
+    }
+    
+    public int decompressInto(byte[] src, double[] dest, int destOff) {
+        return decompressInto(src, 0, src == null ? 0 : src.length, dest, destOff);
+    }
+    
+    public int decompressInto(byte[] src, int srcOff, int srcLen, double[] dest, int destOff) {
+        handle.acquire();
+        try {
+            checkIntoArgs(src, srcOff, srcLen, dest, destOff, dest == null ? 0 : dest.length);
+            if (OpenZLOffload.shouldOffload((long) (dest.length - destOff) * Double.BYTES)) {
+                return OpenZLOffload.call(() -> decompressInto(src, srcOff, srcLen, dest, destOff));
+            }
+            return OpenZLJNI.decompressNumericDoublesInto(nativePtr, src, srcOff, srcLen, dest, destOff);
+        } finally {
+            handle.release();
         }
-        return OpenZLJNI.decompressNumericDoubles(nativePtr, src);
     }
     
     public CompressionInfo getInfo(byte[] src) {
@@ -144,24 +406,34 @@ public final class OpenZLDecompressor implements AutoCloseable {
         return OpenZLJNI.getCompressionInfo(src);
     }
     
+    OpenZLBackend getBackend() {
+        return backend;
+    }
+    
+    boolean isClosed() {
+        return handle.isClosed();
+    }
+    
+    /**
+     * Closes the decompressor. Safe while other threads are still decompressing with it:
+     * the native context is freed once the last of those calls returns.
+     */
     public void close() {
-        if (!closed) {
-            closed = true;
-            OpenZLJNI.destroyDecompressor(nativePtr);
-        }
+        handle.close();
     }
     
-    private void checkNotClosed() {
-        if (closed) {
-            throw new IllegalStateException("Decompressor has been closed");
+    
+    private static void checkIntoArgs(byte[] src, int srcOff, int srcLen, Object dest, int destOff, int destLength) {
+        if (src == null || dest == null) {
+            throw new IllegalArgumentException("Source and destination cannot be null");
+        }
+        checkRange(src, srcOff, srcLen);
+        if (destOff < 0 || destOff > destLength) {
+            throw new IndexOutOfBoundsException("Invalid destination offset: " + destOff + ", array length=" + destLength);
         }
     }
     
-
-    
     private static void checkRange(byte[] buf, int off, int len) {
-        if (off < 0 || len < 0 || off + len > buf.length) {
-            throw new IndexOutOfBoundsException("Invalid range: offset=" + off + ", length=" + len + ", buffer length=" + buf.length);
-        }
+        Objects.checkFromIndexSize(off, len, buf.length);
     }
 }
\ No newline at end of file
@@ -0,0 +1,320 @@
+package net.openzl;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.FunctionDescriptor;
+import java.lang.foreign.Linker;
+import java.lang.foreign.MemoryLayout;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.SegmentAllocator;
+import java.lang.foreign.StructLayout;
+import java.lang.foreign.SymbolLookup;
+import java.lang.invoke.MethodHandle;
+import java.util.Arrays;
+import java.util.Optional;
+
+import static java.lang.foreign.ValueLayout.ADDRESS;
+import static java.lang.foreign.ValueLayout.JAVA_BYTE;
+import static java.lang.foreign.ValueLayout.JAVA_INT;
+import static java.lang.foreign.ValueLayout.JAVA_LONG;
+
+/**
+ * Binds OpenZL directly through java.lang.foreign downcall handles.
+ * Native segments go through the ZL_TypedRef API. Heap segments are passed to critical
+ * downcalls without copying as long as they stay under the critical threshold, which holds
+ * off GC for the call; larger ones are copied through a confined arena.
+ */
+final class OpenZLFFM {
+    
+    // ZL_Report is a union whose members all start with a 32-bit ZL_ErrorCode followed by
+    // a pointer-sized payload (the size_t result on success).
+    private static final StructLayout REPORT = MemoryLayout.structLayout(
+            JAVA_INT.withName("code"),
+            MemoryLayout.paddingLayout(4),
+            JAVA_LONG.withName("value"));
+    private static final long REPORT_CODE = REPORT.byteOffset(MemoryLayout.PathElement.groupElement("code"));
+    private static final long REPORT_VALUE = REPORT.byteOffset(MemoryLayout.PathElement.groupElement("value"));
+    
+    private static final ThreadLocal<MemorySegment> REPORT_BUFFER =
+            ThreadLocal.withInitial(() -> Arena.ofAuto().allocate(REPORT));
+    
+    private static volatile int criticalArrayThreshold =
+            Integer.getInteger("openzl.criticalArrayThreshold", 256 * 1024);
+    
+    private static final class Handles {
+        
+        static final MethodHandle COMPRESSOR_CCTX;
+        static final MethodHandle DECOMPRESSOR_DCTX;
+        static final MethodHandle COMPRESS_BOUND;
+        static final MethodHandle ERROR_CODE_TO_STRING;
+        static final MethodHandle TYPED_REF_CREATE_SERIAL;
+        static final MethodHandle TYPED_REF_CREATE_NUMERIC;
+        static final MethodHandle TYPED_REF_FREE;
+        static final MethodHandle CCTX_COMPRESS_TYPED_REF;
+        static final MethodHandle CCTX_COMPRESS_CRITICAL;
+        static final MethodHandle DCTX_DECOMPRESS;
+        static final MethodHandle DCTX_DECOMPRESS_CRITICAL;
+        static final MethodHandle GET_DECOMPRESSED_SIZE;
+        
+        static {
+            OpenZLJNI.init();
+            
+            Linker linker = Linker.nativeLinker();
+            SymbolLookup lookup = SymbolLookup.loaderLookup().or(openzlLookup());
+            Linker.Option trivial = Linker.Option.critical(false);
+            Linker.Option heapAccess = Linker.Option.critical(true);
+            
+            COMPRESSOR_CCTX = downcall(linker, lookup, "openzl_jni_compressor_cctx",
+                    FunctionDescriptor.of(ADDRESS, JAVA_LONG), trivial);
+            DECOMPRESSOR_DCTX = downcall(linker, lookup, "openzl_jni_decompressor_dctx",
+                    FunctionDescriptor.of(ADDRESS, JAVA_LONG), trivial);
+            COMPRESS_BOUND = downcall(linker, lookup, "ZL_compressBound",
+                    FunctionDescriptor.of(JAVA_LONG, JAVA_LONG), trivial);
+            ERROR_CODE_TO_STRING = downcall(linker, lookup, "ZL_ErrorCode_toString",
+                    FunctionDescriptor.of(ADDRESS, JAVA_INT), trivial);
+            TYPED_REF_CREATE_SERIAL = downcall(linker, lookup, "ZL_TypedRef_createSerial",
+                    FunctionDescriptor.of(ADDRESS, ADDRESS, JAVA_LONG));
+            TYPED_REF_CREATE_NUMERIC = downcall(linker, lookup, "ZL_TypedRef_createNumeric",
+                    FunctionDescriptor.of(ADDRESS, ADDRESS, JAVA_LONG, JAVA_LONG));
+            TYPED_REF_FREE = downcall(linker, lookup, "ZL_TypedRef_free",
+                    FunctionDescriptor.ofVoid(ADDRESS));
+            CCTX_COMPRESS_TYPED_REF = downcall(linker, lookup, "ZL_CCtx_compressTypedRef",
+                    FunctionDescriptor.of(REPORT, ADDRESS, ADDRESS, JAVA_LONG, ADDRESS));
+            CCTX_COMPRESS_CRITICAL = downcall(linker, lookup, "ZL_CCtx_compress",
+                    FunctionDescriptor.of(REPORT, ADDRESS, ADDRESS, JAVA_LONG, ADDRESS, JAVA_LONG), heapAccess);
+            DCTX_DECOMPRESS = downcall(linker, lookup, "ZL_DCtx_decompress",
+                    FunctionDescriptor.of(REPORT, ADDRESS, ADDRESS, JAVA_LONG, ADDRESS, JAVA_LONG));
+            DCTX_DECOMPRESS_CRITICAL = downcall(linker, lookup, "ZL_DCtx_decompress",
+                    FunctionDescriptor.of(REPORT, ADDRESS, ADDRESS, JAVA_LONG, ADDRESS, JAVA_LONG), heapAccess);
+            GET_DECOMPRESSED_SIZE = downcall(linker, lookup, "ZL_getDecompressedSize",
+                    FunctionDescriptor.of(REPORT, ADDRESS, JAVA_LONG), heapAccess);
+        }
+        
+        private static SymbolLookup openzlLookup() {
+            try {
+                return SymbolLookup.libraryLookup(System.mapLibraryName("openzl"), Arena.global());
+            } catch (IllegalArgumentException e) {
+                return name -> Optional.empty();
+            }
+        }
+        
+        private static MethodHandle downcall(Linker linker, SymbolLookup lookup, String name,
+                                             FunctionDescriptor descriptor, Linker.Option... options) {
+            MemorySegment symbol = lookup.find(name)
+                    .orElseThrow(() -> new UnsatisfiedLinkError("OpenZL symbol not found: " + name));
+            return linker.downcallHandle(symbol, descriptor, options);
+        }
+    }
+    
+    static void ensureAvailable() {
+        try {
+            MemorySegment unused = (MemorySegment) Handles.COMPRESSOR_CCTX.invokeExact(0L);
+        } catch (LinkageError e) {
+            throw new OpenZLException("FFM backend is unavailable", e);
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+    }
+    
+    static void setCriticalArrayThreshold(int bytes) {
+        criticalArrayThreshold = bytes;
+    }
+    
+    static long compressBound(long srcSize) {
+        try {
+            return (long) Handles.COMPRESS_BOUND.invokeExact(srcSize);
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+    }
+    
+    static byte[] compress(long compressorPtr, MemorySegment src) {
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment dest = arena.allocate(compressBound(src.byteSize()));
+            long written = compress(compressorPtr, src, dest);
+            return toArray(dest, written);
+        }
+    }
+    
+    static long compress(long compressorPtr, MemorySegment src, MemorySegment dest) {
+        checkWritable(dest);
+        if (!src.isNative() || !dest.isNative()) {
+            if (fitsCritical(src, dest)) {
+                return compressCritical(compressorPtr, src, dest);
+            }
+            return compressStaged(compressorPtr, src, dest);
+        }
+        
+        MemorySegment report = REPORT_BUFFER.get();
+        try {
+            MemorySegment cctx = (MemorySegment) Handles.COMPRESSOR_CCTX.invokeExact(compressorPtr);
+            MemorySegment typedRef = (MemorySegment) Handles.TYPED_REF_CREATE_SERIAL.invokeExact(src, src.byteSize());
+            if (typedRef.equals(MemorySegment.NULL)) {
+                throw new OpenZLException("Failed to create typed reference");
+            }
+            try {
+                report = (MemorySegment) Handles.CCTX_COMPRESS_TYPED_REF.invokeExact(
+                        SegmentAllocator.prefixAllocator(report), cctx, dest, dest.byteSize(), typedRef);
+            } finally {
+                Handles.TYPED_REF_FREE.invokeExact(typedRef);
+            }
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+        return result(report);
+    }
+    
+    static long compressNumeric(long compressorPtr, MemorySegment src, int elementSize, MemorySegment dest) {
+        if (!src.isNative() || !dest.isNative()) {
+            throw new IllegalArgumentException("Numeric compression requires native segments");
+        }
+        checkWritable(dest);
+        if (src.byteSize() % elementSize != 0) {
+            throw new IllegalArgumentException("Segment size is not a multiple of the element size");
+        }
+        
+        MemorySegment report = REPORT_BUFFER.get();
+        try {
+            MemorySegment cctx = (MemorySegment) Handles.COMPRESSOR_CCTX.invokeExact(compressorPtr);
+            MemorySegment typedRef = (MemorySegment) Handles.TYPED_REF_CREATE_NUMERIC.invokeExact(
+                    src, (long) elementSize, src.byteSize() / elementSize);
+            if (typedRef.equals(MemorySegment.NULL)) {
+                throw new OpenZLException("Failed to create typed reference for numeric data");
+            }
+            try {
+                report = (MemorySegment) Handles.CCTX_COMPRESS_TYPED_REF.invokeExact(
+                        SegmentAllocator.prefixAllocator(report), cctx, dest, dest.byteSize(), typedRef);
+            } finally {
+                Handles.TYPED_REF_FREE.invokeExact(typedRef);
+            }
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+        return result(report);
+    }
+    
+    static long decompressedSize(MemorySegment src) {
+        MemorySegment report = REPORT_BUFFER.get();
+        try {
+            report = (MemorySegment) Handles.GET_DECOMPRESSED_SIZE.invokeExact(
+                    SegmentAllocator.prefixAllocator(report), src, src.byteSize());
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+        return result(report);
+    }
+    
+    static byte[] decompress(long decompressorPtr, MemorySegment src) {
+        long size = decompressedSize(src);
+        if (size > Integer.MAX_VALUE - 8) {
+            throw new OpenZLException("Decompressed size exceeds the maximum array size: " + size);
+        }
+        byte[] dest = new byte[(int) size];
+        long written = decompress(decompressorPtr, src, MemorySegment.ofArray(dest));
+        return written == dest.length ? dest : Arrays.copyOf(dest, (int) written);
+    }
+    
+    static long decompress(long decompressorPtr, MemorySegment src, MemorySegment dest) {
+        checkWritable(dest);
+        boolean allNative = src.isNative() && dest.isNative();
+        if (!allNative && !fitsCritical(src, dest)) {
+            return decompressStaged(decompressorPtr, src, dest);
+        }
+        
+        MemorySegment report = REPORT_BUFFER.get();
+        try {
+            MemorySegment dctx = (MemorySegment) Handles.DECOMPRESSOR_DCTX.invokeExact(decompressorPtr);
+            MethodHandle handle = allNative ? Handles.DCTX_DECOMPRESS : Handles.DCTX_DECOMPRESS_CRITICAL;
+            report = (MemorySegment) handle.invokeExact(
+                    SegmentAllocator.prefixAllocator(report), dctx, dest, dest.byteSize(), src, src.byteSize());
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+        return result(report);
+    }
+    
+    private static long compressCritical(long compressorPtr, MemorySegment src, MemorySegment dest) {
+        MemorySegment report = REPORT_BUFFER.get();
+        try {
+            MemorySegment cctx = (MemorySegment) Handles.COMPRESSOR_CCTX.invokeExact(compressorPtr);
+            report = (MemorySegment) Handles.CCTX_COMPRESS_CRITICAL.invokeExact(
+                    SegmentAllocator.prefixAllocator(report), cctx, dest, dest.byteSize(), src, src.byteSize());
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+        return result(report);
+    }
+    
+    private static long compressStaged(long compressorPtr, MemorySegment src, MemorySegment dest) {
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment nativeSrc = src.isNative() ? src : arena.allocate(src.byteSize()).copyFrom(src);
+            MemorySegment nativeDest = dest.isNative() ? dest : arena.allocate(dest.byteSize());
+            long written = compress(compressorPtr, nativeSrc, nativeDest);
+            if (nativeDest != dest) {
+                MemorySegment.copy(nativeDest, 0, dest, 0, written);
+            }
+            return written;
+        }
+    }
+    
+    private static long decompressStaged(long decompressorPtr, MemorySegment src, MemorySegment dest) {
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment nativeSrc = src.isNative() ? src : arena.allocate(src.byteSize()).copyFrom(src);
+            MemorySegment nativeDest = dest.isNative() ? dest : arena.allocate(dest.byteSize());
+            long written = decompress(decompressorPtr, nativeSrc, nativeDest);
+            if (nativeDest != dest) {
+                MemorySegment.copy(nativeDest, 0, dest, 0, written);
+            }
+            return written;
+        }
+    }
+    
+    private static boolean fitsCritical(MemorySegment src, MemorySegment dest) {
+        return src.byteSize() + dest.byteSize() <= criticalArrayThreshold;
+    }
+    
+    private static void checkWritable(MemorySegment dest) {
+        if (dest.isReadOnly()) {
+            throw new IllegalArgumentException("Destination segment is read-only");
+        }
+    }
+    
+    private static byte[] toArray(MemorySegment segment, long length) {
+        if (length > Integer.MAX_VALUE - 8) {
+            throw new OpenZLException("Result exceeds the maximum array size: " + length);
+        }
+        return segment.asSlice(0, length).toArray(JAVA_BYTE);
+    }
+    
+    private static long result(MemorySegment report) {
+        int code = report.get(JAVA_INT, REPORT_CODE);
+        if (code != 0) {
+            throw new OpenZLException(errorString(code));
+        }
+        return report.get(JAVA_LONG, REPORT_VALUE);
+    }
+    
+    private static String errorString(int code) {
+        try {
+            MemorySegment message = (MemorySegment) Handles.ERROR_CODE_TO_STRING.invokeExact(code);
+            if (message.equals(MemorySegment.NULL)) {
+                return "OpenZL error " + code;
+            }
+            return message.reinterpret(Long.MAX_VALUE).getString(0);
+        } catch (Throwable t) {
+            throw propagate(t);
+        }
+    }
+    
+    private static RuntimeException propagate(Throwable t) {
+        if (t instanceof Error e) {
+            throw e;
+        }
+        if (t instanceof RuntimeException e) {
+            return e;
+        }
+        return new OpenZLException("FFM call failed", t);
+    }
+    
+    private OpenZLFFM() {
+    }
+}
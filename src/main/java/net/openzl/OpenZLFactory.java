@@ -5,6 +5,9 @@ public final class OpenZLFactory {
     private static final OpenZLFactory FASTEST_INSTANCE = new OpenZLFactory();
     private static final OpenZLFactory SAFE_INSTANCE = new OpenZLFactory();
     
+    private static volatile OpenZLBackend backend =
+            OpenZLBackend.fromProperty(System.getProperty("openzl.backend"));
+    
     static {
         OpenZLJNI.init();
     }
@@ -42,6 +45,69 @@ public final class OpenZLFactory {
         return new OpenZLDecompressor();
     }
     
+    /**
+     * Combined source + destination size up to which array-to-array calls pin the arrays
+     * instead of copying them (default 256 KB, 0 disables, or -Dopenzl.criticalArrayThreshold).
+     */
+    public static void setCriticalArrayThreshold(int bytes) {
+        if (bytes < 0) {
+            throw new IllegalArgumentException("Threshold cannot be negative");
+        }
+        init();
+        OpenZLJNI.setCriticalArrayThreshold(bytes);
+        OpenZLFFM.setCriticalArrayThreshold(bytes);
+    }
+    
+    /**
+     * Largest scratch block, in bytes, each native thread keeps between calls for staging
+     * buffers (default 64 MB, 0 disables, or -Dopenzl.scratchRetainLimit).
+     */
+    public static void setScratchArenaRetainLimit(long bytes) {
+        if (bytes < 0) {
+            throw new IllegalArgumentException("Retain limit cannot be negative");
+        }
+        init();
+        OpenZLJNI.setScratchArenaRetainLimit(bytes);
+    }
+    
+    /**
+     * Size in bytes from which calls made on virtual threads run on a small platform-thread
+     * pool while the virtual thread parks, instead of pinning its carrier for the whole
+     * native call. Covers every compressor, decompressor and OpenZLFiles call except the
+     * MemorySegment ones. Negative disables offloading. Defaults to 256 KB or
+     * -Dopenzl.virtualThreadOffloadThreshold.
+     */
+    public static void setVirtualThreadOffloadThreshold(int bytes) {
+        OpenZLOffload.setThreshold(bytes);
+    }
+    
+    public static int getVirtualThreadOffloadThreshold() {
+        return OpenZLOffload.getThreshold();
+    }
+    
+    public static ScratchArenaStats scratchArenaStats() {
+        init();
+        return new ScratchArenaStats(OpenZLJNI.getScratchArenaStats());
+    }
+    
+    /**
+     * Selects the binding used by instances created afterwards for byte[] and ByteBuffer
+     * calls. MemorySegment overloads always use FFM. Defaults to -Dopenzl.backend or JNI.
+     */
+    public static void setBackend(OpenZLBackend newBackend) {
+        if (newBackend == null) {
+            throw new IllegalArgumentException("Backend cannot be null");
+        }
+        if (newBackend == OpenZLBackend.FFM) {
+            OpenZLFFM.ensureAvailable();
+        }
+        backend = newBackend;
+    }
+    
+    public static OpenZLBackend getBackend() {
+        return backend;
+    }
+    
     private static void init() {
         OpenZLJNI.init();
     }
@@ -0,0 +1,288 @@
+package net.openzl;
+
+import java.io.IOException;
+import java.nio.channels.FileChannel;
+import java.nio.charset.Charset;
+import java.nio.file.FileSystems;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Locale;
+
+/**
+ * File-to-file compression into block containers (see OpenZLFrameFormat) with the whole
+ * loop in native code. The source is memory-mapped, rounds of blocks are compressed on the
+ * native worker pool, and finished blocks are written in order with pwrite, so no payload
+ * byte crosses into the JVM and the only copies are the kernel's. With dropCache, each
+ * round's input and output ranges are dropped from the page cache once written, which
+ * keeps bulk jobs on multi-GB files from evicting the rest of the machine's cache.
+ *
+ * The native worker pool is shared by the whole process, including OpenZLParallel's
+ * MemorySegment overloads. Each round waits until as many workers are idle as it uses, so
+ * concurrent calls with the default of every worker take turns round by round, while
+ * calls capped with Options.withThreads run side by side on disjoint workers.
+ *
+ * On Linux builds linked against liburing, Options.withIoUring switches compression to an
+ * io_uring loop with registered buffers: the reads for the next round of blocks are queued
+ * while the pool compresses the current one, and the previous round is written out
+ * meanwhile, so compression rarely waits on a syscall. Without a usable ring it quietly
+ * uses the mapped path.
+ *
+ * The native path needs POSIX and a path on the default file system. Otherwise, such as on
+ * Windows or for a zip file system path, both methods fall back to OpenZLPipeline over
+ * FileChannels, which writes the same container format.
+ */
+public final class OpenZLFiles {
+    
+    private static final boolean NATIVE_FILES =
+            !System.getProperty("os.name", "").toLowerCase(Locale.ROOT).startsWith("windows");
+    private static final Charset PATH_CHARSET = pathCharset();
+    
+    /**
+     * Immutable settings for compress and decompress; start from defaults() and derive
+     * copies with the with* methods.
+     */
+    public static final class Options {
+        private static final Options DEFAULTS = new Options(CompressionGraph.ZSTD,
+                OpenZLFrameFormat.DEFAULT_BLOCK_SIZE, 0, false, false);
+        
+        private final CompressionGraph graph;
+        private final int blockSize;
+        private final int threads;
+        private final boolean dropCache;
+        private final boolean ioUring;
+        
+        private Options(CompressionGraph graph, int blockSize, int threads, boolean dropCache, boolean ioUring) {
+            this.graph = graph;
+            this.blockSize = blockSize;
+            this.threads = threads;
+            this.dropCache = dropCache;
+            this.ioUring = ioUring;
+        }
+        
+        /**
+         * ZSTD graph, 4 MB blocks, every pool worker, page cache left alone, mapped I/O.
+         */
+        public static Options defaults() {
+            return DEFAULTS;
+        }
+        
+        public Options withGraph(CompressionGraph graph) {
+            if (graph == null) {
+                throw new IllegalArgumentException("Compression graph cannot be null");
+            }
+            return new Options(graph, blockSize, threads, dropCache, ioUring);
+        }
+        
+        /**
+         * Block size of containers written by compress; decompress uses the container's own.
+         */
+        public Options withBlockSize(int blockSize) {
+            OpenZLFrameFormat.checkBlockSize(blockSize);
+            return new Options(graph, blockSize, threads, dropCache, ioUring);
+        }
+        
+        /**
+         * Caps the workers used; 0 uses every worker of the native pool, 1 runs serially.
+         * Capped calls leave the remaining workers to other concurrent jobs.
+         */
+        public Options withThreads(int threads) {
+            if (threads < 0) {
+                throw new IllegalArgumentException("Thread count cannot be negative");
+            }
+            return new Options(graph, blockSize, threads, dropCache, ioUring);
+        }
+        
+        /**
+         * Drops the source and destination ranges from the page cache behind the job. Only
+         * honoured by the native path.
+         */
+        public Options withDropCache(boolean dropCache) {
+            return new Options(graph, blockSize, threads, dropCache, ioUring);
+        }
+        
+        /**
+         * Drives compression I/O through io_uring where isIoUringAvailable() is true;
+         * ignored elsewhere and by decompress.
+         */
+        public Options withIoUring(boolean ioUring) {
+            return new Options(graph, blockSize, threads, dropCache, ioUring);
+        }
+        
+        public CompressionGraph getGraph() {
+            return graph;
+        }
+        
+        public int getBlockSize() {
+            return blockSize;
+        }
+        
+        public int getThreads() {
+            return threads;
+        }
+        
+        public boolean isDropCache() {
+            return dropCache;
+        }
+        
+        public boolean isIoUring() {
+            return ioUring;
+        }
+    }
+    
+    static {
+        OpenZLJNI.init();
+    }
+    
+    private OpenZLFiles() {
+    }
+    
+    /**
+     * Whether the library was built with liburing and the kernel lets this process create
+     * a ring; container seccomp profiles often do not.
+     */
+    public static boolean isIoUringAvailable() {
+        return NATIVE_FILES && OpenZLJNI.ioUringAvailable();
+    }
+    
+    public static long compress(Path src, Path dest) throws IOException {
+        return compress(src, dest, Options.defaults());
+    }
+    
+    /**
+     * Compresses src into an indexed block container at dest, replacing any existing file
+     * other than src itself. Returns the container size. A failed call deletes the partly
+     * written dest.
+     */
+    public static long compress(Path src, Path dest, Options options) throws IOException {
+        checkArguments(src, dest, options);
+        if (OpenZLOffload.shouldOffload(Files.size(src))) {
+            return OpenZLOffload.callIO(() -> compress(src, dest, options));
+        }
+        if (isNative(src, dest)) {
+            try {
+                return OpenZLJNI.compressFile(nativePath(src), nativePath(dest), options.graph.getId(),
+                        options.blockSize, options.threads, options.dropCache, options.ioUring);
+            } catch (UnsupportedOperationException e) {
+                // No native file support on this platform; use the pipeline.
+            }
+        }
+        try (FileChannel in = FileChannel.open(src, StandardOpenOption.READ)) {
+            FileChannel out = openDestination(dest);
+            try (out) {
+                return pipeline(options).compress(in, out);
+            } catch (IOException | RuntimeException e) {
+                discard(dest, e);
+                throw e;
+            }
+        }
+    }
+    
+    public static long decompress(Path src, Path dest) throws IOException {
+        return decompress(src, dest, Options.defaults());
+    }
+    
+    /**
+     * Decompresses the block container at src into dest, replacing any existing file other
+     * than src itself. Returns the number of bytes written. A failed call deletes the partly
+     * written dest.
+     */
+    public static long decompress(Path src, Path dest, Options options) throws IOException {
+        checkArguments(src, dest, options);
+        if (OpenZLOffload.shouldOffload(Files.size(src))) {
+            return OpenZLOffload.callIO(() -> decompress(src, dest, options));
+        }
+        if (isNative(src, dest)) {
+            try {
+                return OpenZLJNI.decompressFile(nativePath(src), nativePath(dest), options.threads,
+                        options.dropCache);
+            } catch (UnsupportedOperationException e) {
+                // No native file support on this platform; use the pipeline.
+            }
+        }
+        try (FileChannel in = FileChannel.open(src, StandardOpenOption.READ)) {
+            FileChannel out = openDestination(dest);
+            try (out) {
+                return pipeline(options).decompress(in, out);
+            } catch (IOException | RuntimeException e) {
+                discard(dest, e);
+                throw e;
+            }
+        }
+    }
+    
+    /**
+     * Also rejects src and dest naming the same file, through a link or otherwise: the
+     * destination is truncated before the source has been read.
+     */
+    private static void checkArguments(Path src, Path dest, Options options) throws IOException {
+        if (src == null || dest == null) {
+            throw new IllegalArgumentException("Source and destination paths cannot be null");
+        }
+        if (options == null) {
+            throw new IllegalArgumentException("Options cannot be null");
+        }
+        checkDistinct(src, dest);
+    }
+    
+    /**
+     * Throws if src and dest name the same file, through a link or otherwise, since writing
+     * dest would truncate the input before it is read.
+     */
+    static void checkDistinct(Path src, Path dest) throws IOException {
+        if (Files.exists(dest) && Files.isSameFile(src, dest)) {
+            throw new IOException("Source and destination are the same file: " + dest);
+        }
+    }
+    
+    /**
+     * Deletes a destination a failed call left half-written, recording any failure to do so
+     * on the original exception.
+     */
+    static void discard(Path dest, Exception failure) {
+        try {
+            Files.deleteIfExists(dest);
+        } catch (IOException e) {
+            failure.addSuppressed(e);
+        }
+    }
+    
+    private static boolean isNative(Path src, Path dest) {
+        return NATIVE_FILES && src.getFileSystem() == FileSystems.getDefault()
+                && dest.getFileSystem() == FileSystems.getDefault();
+    }
+    
+    /**
+     * The path as the platform encodes file names, the same charset the JDK's own file
+     * system provider uses. Interior NULs would silently shorten the C string, so they are
+     * rejected.
+     */
+    private static byte[] nativePath(Path path) {
+        byte[] bytes = path.toString().getBytes(PATH_CHARSET);
+        for (byte b : bytes) {
+            if (b == 0) {
+                throw new IllegalArgumentException("Path contains a NUL character: " + path);
+            }
+        }
+        return bytes;
+    }
+    
+    private static Charset pathCharset() {
+        String name = System.getProperty("sun.jnu.encoding");
+        try {
+            return name == null ? Charset.defaultCharset() : Charset.forName(name);
+        } catch (IllegalArgumentException e) {
+            return Charset.defaultCharset();
+        }
+    }
+    
+    private static FileChannel openDestination(Path dest) throws IOException {
+        return FileChannel.open(dest, StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING,
+                StandardOpenOption.WRITE);
+    }
+    
+    private static OpenZLPipeline pipeline(Options options) {
+        int workers = options.threads > 0 ? options.threads : Runtime.getRuntime().availableProcessors();
+        return new OpenZLPipeline(options.graph, options.blockSize, workers);
+    }
+}
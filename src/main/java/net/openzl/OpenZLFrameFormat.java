@@ -0,0 +1,247 @@
+package net.openzl;
+
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.ByteOrder;
+import java.util.Arrays;
+
+/**
+ * Block container shared by the parallel, streaming and seekable APIs. All fields are
+ * little-endian:
+ *
+ *   header   magic "OZLB" u32 | version u8 | flags u8 | reserved u16 | blockSize u32 | reserved u32
+ *   block*   compressedSize u32 | rawSize u32 | one OpenZL frame of compressedSize bytes
+ *   end      u32 0
+ *   index    (flags & FLAG_INDEXED) per block: frameOffset u64 | compressedSize u32 | rawSize u32
+ *   trailer  (flags & FLAG_INDEXED) indexOffset u64 | blockCount u32 | magic "OZLX" u32
+ *
+ * Every block is an independent frame, so blocks can be decoded in any order. Offsets in
+ * the index are absolute from the start of the container.
+ */
+final class OpenZLFrameFormat {
+    
+    static final int MAGIC = 0x424C5A4F;
+    static final int INDEX_MAGIC = 0x584C5A4F;
+    static final int VERSION = 1;
+    static final int FLAG_INDEXED = 1;
+    
+    static final int HEADER_SIZE = 16;
+    static final int BLOCK_HEADER_SIZE = 8;
+    static final int END_MARKER_SIZE = 4;
+    static final int INDEX_ENTRY_SIZE = 16;
+    static final int TRAILER_SIZE = 16;
+    
+    static final int DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+    static final int MIN_BLOCK_SIZE = 4 * 1024;
+    static final int MAX_BLOCK_SIZE = 1 << 30;
+    
+    static final ValueLayout.OfInt INT = ValueLayout.JAVA_INT_UNALIGNED.withOrder(ByteOrder.LITTLE_ENDIAN);
+    static final ValueLayout.OfLong LONG = ValueLayout.JAVA_LONG_UNALIGNED.withOrder(ByteOrder.LITTLE_ENDIAN);
+    
+    private OpenZLFrameFormat() {
+    }
+    
+    /**
+     * Location of every block in a container: frame bytes at frameOffset, decoded bytes at
+     * rawOffset of the output.
+     */
+    static final class BlockTable {
+        final int blockSize;
+        final int count;
+        final long[] frameOffsets;
+        final int[] compressedSizes;
+        final long[] rawOffsets;
+        final int[] rawSizes;
+        final long rawSize;
+        final long containerSize;
+        
+        BlockTable(int blockSize, int count, long[] frameOffsets, int[] compressedSizes, int[] rawSizes,
+                   long containerSize) {
+            this.blockSize = blockSize;
+            this.count = count;
+            this.frameOffsets = frameOffsets;
+            this.compressedSizes = compressedSizes;
+            this.rawSizes = rawSizes;
+            this.rawOffsets = new long[count];
+            long total = 0;
+            for (int i = 0; i < count; i++) {
+                rawOffsets[i] = total;
+                total += rawSizes[i];
+            }
+            this.rawSize = total;
+            this.containerSize = containerSize;
+        }
+    }
+    
+    static void checkBlockSize(int blockSize) {
+        if (blockSize < MIN_BLOCK_SIZE || blockSize > MAX_BLOCK_SIZE) {
+            throw new IllegalArgumentException("Block size must be between " + MIN_BLOCK_SIZE + " and " + MAX_BLOCK_SIZE);
+        }
+    }
+    
+    static void writeHeader(MemorySegment dest, long offset, int flags, int blockSize) {
+        dest.set(INT, offset, MAGIC);
+        dest.set(INT, offset + 4, VERSION | (flags << 8));
+        dest.set(INT, offset + 8, blockSize);
+        dest.set(INT, offset + 12, 0);
+    }
+    
+    static void writeBlockHeader(MemorySegment dest, long offset, int compressedSize, int rawSize) {
+        dest.set(INT, offset, compressedSize);
+        dest.set(INT, offset + 4, rawSize);
+    }
+    
+    static int indexSize(int blockCount) {
+        return blockCount * INDEX_ENTRY_SIZE + TRAILER_SIZE;
+    }
+    
+    /**
+     * Writes the end marker, the index and the trailer starting at offset, which must be
+     * the end of the last block. Returns the offset just past the trailer.
+     */
+    static long writeFooter(MemorySegment dest, long offset, BlockTable table) {
+        return writeFooter(dest, offset, offset, table);
+    }
+    
+    /**
+     * Same as writeFooter(dest, offset, table) for a footer that lands at containerOffset
+     * of the container but is staged at offset of dest, as when streaming it to a channel.
+     */
+    static long writeFooter(MemorySegment dest, long offset, long containerOffset, BlockTable table) {
+        dest.set(INT, offset, 0);
+        long pos = offset + END_MARKER_SIZE;
+        for (int i = 0; i < table.count; i++) {
+            dest.set(LONG, pos, table.frameOffsets[i]);
+            dest.set(INT, pos + 8, table.compressedSizes[i]);
+            dest.set(INT, pos + 12, table.rawSizes[i]);
+            pos += INDEX_ENTRY_SIZE;
+        }
+        dest.set(LONG, pos, containerOffset + END_MARKER_SIZE);
+        dest.set(INT, pos + 8, table.count);
+        dest.set(INT, pos + 12, INDEX_MAGIC);
+        return pos + TRAILER_SIZE;
+    }
+    
+    static boolean isContainer(MemorySegment src) {
+        return src.byteSize() >= HEADER_SIZE && src.get(INT, 0) == MAGIC;
+    }
+    
+    /**
+     * Reads the block table of the container at the start of src, from the index when the
+     * container is flagged as indexed and by walking the block headers otherwise; a flagged
+     * container without a valid trailer is corrupt. Raw sizes are checked against the block
+     * size. The native reader (container_table_read) applies the same rules.
+     */
+    static BlockTable readBlockTable(MemorySegment src) {
+        if (!isContainer(src)) {
+            throw new OpenZLException("Not an OpenZL block container");
+        }
+        int versionAndFlags = src.get(INT, 4);
+        if ((versionAndFlags & 0xFF) != VERSION) {
+            throw new OpenZLException("Unsupported block container version: " + (versionAndFlags & 0xFF));
+        }
+        int flags = (versionAndFlags >>> 8) & 0xFF;
+        int blockSize = src.get(INT, 8);
+        if (blockSize < MIN_BLOCK_SIZE || blockSize > MAX_BLOCK_SIZE) {
+            throw corrupt("invalid block size");
+        }
+        
+        if ((flags & FLAG_INDEXED) != 0) {
+            return readIndex(src, blockSize);
+        }
+        return scanBlocks(src, blockSize);
+    }
+    
+    /**
+     * Block table for a plain run of concatenated frames, built from the (frameOffset,
+     * compressedSize, decompressedSize) triples returned by OpenZLJNI.scanFrames.
+     */
+    static BlockTable frameTable(long[] frames, long size) {
+        int count = frames.length / 3;
+        long[] frameOffsets = new long[count];
+        int[] compressedSizes = new int[count];
+        int[] rawSizes = new int[count];
+        for (int i = 0; i < count; i++) {
+            if (frames[3 * i + 1] > Integer.MAX_VALUE || frames[3 * i + 2] > Integer.MAX_VALUE) {
+                throw new OpenZLException("Frame " + i + " exceeds 2 GB and cannot be decoded as a block");
+            }
+            frameOffsets[i] = frames[3 * i];
+            compressedSizes[i] = (int) frames[3 * i + 1];
+            rawSizes[i] = (int) frames[3 * i + 2];
+        }
+        return new BlockTable(0, count, frameOffsets, compressedSizes, rawSizes, size);
+    }
+    
+    private static BlockTable readIndex(MemorySegment src, int blockSize) {
+        long size = src.byteSize();
+        if (size < HEADER_SIZE + END_MARKER_SIZE + TRAILER_SIZE) {
+            throw corrupt("truncated trailer");
+        }
+        long trailer = size - TRAILER_SIZE;
+        long indexOffset = src.get(LONG, trailer);
+        int count = src.get(INT, trailer + 8);
+        if (src.get(INT, trailer + 12) != INDEX_MAGIC || count < 0
+                || indexOffset < HEADER_SIZE + END_MARKER_SIZE
+                || indexOffset + (long) count * INDEX_ENTRY_SIZE != trailer) {
+            throw corrupt("invalid index");
+        }
+        
+        long[] frameOffsets = new long[count];
+        int[] compressedSizes = new int[count];
+        int[] rawSizes = new int[count];
+        for (int i = 0; i < count; i++) {
+            long entry = indexOffset + (long) i * INDEX_ENTRY_SIZE;
+            frameOffsets[i] = src.get(LONG, entry);
+            compressedSizes[i] = src.get(INT, entry + 8);
+            rawSizes[i] = src.get(INT, entry + 12);
+            if (frameOffsets[i] < HEADER_SIZE + BLOCK_HEADER_SIZE || compressedSizes[i] <= 0
+                    || rawSizes[i] < 0 || rawSizes[i] > blockSize
+                    || frameOffsets[i] > indexOffset - END_MARKER_SIZE - compressedSizes[i]) {
+                throw corrupt("index entry " + i + " out of bounds");
+            }
+        }
+        return new BlockTable(blockSize, count, frameOffsets, compressedSizes, rawSizes, size);
+    }
+    
+    private static BlockTable scanBlocks(MemorySegment src, int blockSize) {
+        long size = src.byteSize();
+        long pos = HEADER_SIZE;
+        int count = 0;
+        long[] frameOffsets = new long[16];
+        int[] compressedSizes = new int[16];
+        int[] rawSizes = new int[16];
+        while (true) {
+            if (pos + END_MARKER_SIZE > size) {
+                throw corrupt("missing end marker");
+            }
+            int compressedSize = src.get(INT, pos);
+            if (compressedSize == 0) {
+                pos += END_MARKER_SIZE;
+                break;
+            }
+            if (pos + BLOCK_HEADER_SIZE > size) {
+                throw corrupt("truncated block header");
+            }
+            int rawSize = src.get(INT, pos + 4);
+            if (compressedSize < 0 || rawSize < 0 || rawSize > blockSize
+                    || pos + BLOCK_HEADER_SIZE + compressedSize > size) {
+                throw corrupt("block " + count + " out of bounds");
+            }
+            if (count == frameOffsets.length) {
+                frameOffsets = Arrays.copyOf(frameOffsets, count * 2);
+                compressedSizes = Arrays.copyOf(compressedSizes, count * 2);
+                rawSizes = Arrays.copyOf(rawSizes, count * 2);
+            }
+            frameOffsets[count] = pos + BLOCK_HEADER_SIZE;
+            compressedSizes[count] = compressedSize;
+            rawSizes[count] = rawSize;
+            count++;
+            pos += BLOCK_HEADER_SIZE + compressedSize;
+        }
+        return new BlockTable(blockSize, count, frameOffsets, compressedSizes, rawSizes, pos);
+    }
+    
+    private static OpenZLException corrupt(String detail) {
+        return new OpenZLException("Corrupt OpenZL block container: " + detail);
+    }
+}
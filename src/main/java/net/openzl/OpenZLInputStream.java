@@ -0,0 +1,153 @@
+package net.openzl;
+
+import java.io.EOFException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.foreign.MemorySegment;
+import java.util.Objects;
+
+/**
+ * Reads back a block container written by OpenZLOutputStream, OpenZLPipeline or
+ * OpenZLParallel as a plain byte stream. One block is decoded at a time with a reused
+ * decompressor, so memory is one compressed frame plus one decoded block, about
+ * 2 * blockSize, however large the payload.
+ *
+ * The header is read by the constructor. Reading stops at the end marker; the index after
+ * it is left unread. Not thread-safe.
+ */
+public final class OpenZLInputStream extends InputStream {
+    
+    private final InputStream in;
+    private final OpenZLDecompressor decompressor;
+    private final int blockSize;
+    private final byte[] blockHeader = new byte[OpenZLFrameFormat.BLOCK_HEADER_SIZE];
+    private final byte[] frame;
+    private final byte[] block;
+    private int position;
+    private int limit;
+    private boolean eof = false;
+    private boolean closed = false;
+    
+    public OpenZLInputStream(InputStream in) throws IOException {
+        if (in == null) {
+            throw new IllegalArgumentException("Input stream cannot be null");
+        }
+        this.in = in;
+        
+        byte[] header = new byte[OpenZLFrameFormat.HEADER_SIZE];
+        readFully(header, 0, header.length);
+        MemorySegment segment = MemorySegment.ofArray(header);
+        if (!OpenZLFrameFormat.isContainer(segment)) {
+            throw new OpenZLException("Not an OpenZL block container");
+        }
+        int version = segment.get(OpenZLFrameFormat.INT, 4) & 0xFF;
+        if (version != OpenZLFrameFormat.VERSION) {
+            throw new OpenZLException("Unsupported block container version: " + version);
+        }
+        int size = segment.get(OpenZLFrameFormat.INT, 8);
+        if (size < OpenZLFrameFormat.MIN_BLOCK_SIZE || size > OpenZLFrameFormat.MAX_BLOCK_SIZE) {
+            throw new OpenZLException("Corrupt OpenZL block container: invalid block size " + size);
+        }
+        
+        this.blockSize = size;
+        this.frame = new byte[OpenZLCompressor.maxCompressedLength(size)];
+        this.block = new byte[size];
+        this.decompressor = OpenZLFactory.fastDecompressor();
+    }
+    
+    @Override
+    public int read() throws IOException {
+        if (position == limit && !fill()) {
+            return -1;
+        }
+        return block[position++] & 0xFF;
+    }
+    
+    @Override
+    public int read(byte[] b, int off, int len) throws IOException {
+        Objects.checkFromIndexSize(off, len, b.length);
+        if (len == 0) {
+            return 0;
+        }
+        if (position == limit && !fill()) {
+            return -1;
+        }
+        int n = Math.min(len, limit - position);
+        System.arraycopy(block, position, b, off, n);
+        position += n;
+        return n;
+    }
+    
+    /**
+     * Bytes left in the current decoded block.
+     */
+    @Override
+    public int available() throws IOException {
+        ensureOpen();
+        return limit - position;
+    }
+    
+    @Override
+    public void close() throws IOException {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        try {
+            decompressor.close();
+        } finally {
+            in.close();
+        }
+    }
+    
+    public int getBlockSize() {
+        return blockSize;
+    }
+    
+    /**
+     * Decodes the next non-empty block into the block buffer; returns false at the end
+     * marker.
+     */
+    private boolean fill() throws IOException {
+        ensureOpen();
+        while (!eof) {
+            readFully(blockHeader, 0, OpenZLFrameFormat.END_MARKER_SIZE);
+            MemorySegment segment = MemorySegment.ofArray(blockHeader);
+            int compressedSize = segment.get(OpenZLFrameFormat.INT, 0);
+            if (compressedSize == 0) {
+                eof = true;
+                break;
+            }
+            readFully(blockHeader, OpenZLFrameFormat.END_MARKER_SIZE,
+                    OpenZLFrameFormat.BLOCK_HEADER_SIZE - OpenZLFrameFormat.END_MARKER_SIZE);
+            int rawSize = segment.get(OpenZLFrameFormat.INT, 4);
+            if (compressedSize < 0 || compressedSize > frame.length || rawSize < 0 || rawSize > blockSize) {
+                throw new OpenZLException("Corrupt OpenZL block container: block sizes out of bounds");
+            }
+            
+            readFully(frame, 0, compressedSize);
+            int decoded = decompressor.decompress(frame, 0, compressedSize, block, 0, rawSize);
+            if (decoded != rawSize) {
+                throw new OpenZLException("Block decompressed to " + decoded + " bytes, expected " + rawSize);
+            }
+            position = 0;
+            limit = rawSize;
+            if (rawSize > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    private void readFully(byte[] buffer, int off, int len) throws IOException {
+        if (in.readNBytes(buffer, off, len) != len) {
+            throw new EOFException("Truncated OpenZL block container");
+        }
+    }
+    
+    private void ensureOpen() throws IOException {
+        if (closed) {
+            throw new IOException("Stream closed");
+        }
+    }
+}
@@ -1,15 +1,37 @@
 package net.openzl;
 
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.concurrent.locks.ReentrantLock;
+
 final class OpenZLJNI {
     
-    private static boolean initialized = false;
+    private static volatile boolean initialized = false;
+    private static final ReentrantLock INIT_LOCK = new ReentrantLock();
     private static final String LIBRARY_NAME = "openzl_jni";
+    private static final String CRITICAL_THRESHOLD_PROPERTY = "openzl.criticalArrayThreshold";
+    private static final String SCRATCH_RETAIN_LIMIT_PROPERTY = "openzl.scratchRetainLimit";
     
-    static synchronized void init() {
+    /**
+     * Loads the library once. The fast path is a single volatile read, and the slow path
+     * takes a ReentrantLock rather than a monitor, so virtual threads racing to initialise
+     * park instead of pinning their carriers.
+     */
+    static void init() {
         if (initialized) {
             return;
         }
-        
+        INIT_LOCK.lock();
+        try {
+            if (!initialized) {
+                load();
+            }
+        } finally {
+            INIT_LOCK.unlock();
+        }
+    }
+    
+    private static void load() {
         try {
             System.loadLibrary(LIBRARY_NAME);
         } catch (UnsatisfiedLinkError e) {
@@ -21,12 +43,25 @@ final class OpenZLJNI {
         }
         
         nativeInit();
+        
+        Integer criticalThreshold = Integer.getInteger(CRITICAL_THRESHOLD_PROPERTY);
+        if (criticalThreshold != null) {
+            setCriticalArrayThreshold(criticalThreshold);
+        }
+        Long scratchRetainLimit = Long.getLong(SCRATCH_RETAIN_LIMIT_PROPERTY);
+        if (scratchRetainLimit != null) {
+            setScratchArenaRetainLimit(scratchRetainLimit);
+        }
         initialized = true;
     }
     
     private static native void nativeInit();
     private static native void nativeShutdown();
     
+    static native void setCriticalArrayThreshold(int threshold);
+    static native void setScratchArenaRetainLimit(long limit);
+    static native long[] getScratchArenaStats();
+    
     static native long createCompressor(int graphId);
     static native void destroyCompressor(long compressorPtr);
     static native long createDecompressor();
@@ -35,6 +70,8 @@ final class OpenZLJNI {
     static native byte[] compressSerial(long compressorPtr, byte[] src, int srcOff, int srcLen);
     static native int compressSerialToBuffer(long compressorPtr, byte[] src, int srcOff, int srcLen,
                                            byte[] dest, int destOff, int maxDestLen);
+    static native int compressDirect(long compressorPtr, ByteBuffer src, int srcPos, int srcLen,
+                                     ByteBuffer dest, int destPos, int maxDestLen);
     
     static native byte[] compressNumeric(long compressorPtr, byte[] data, int elementSize, int elementCount);
     static native byte[] compressNumericInts(long compressorPtr, int[] data);
@@ -45,15 +82,42 @@ final class OpenZLJNI {
     static native byte[] decompressSerial(long decompressorPtr, byte[] src, int srcOff, int srcLen);
     static native int decompressSerialToBuffer(long decompressorPtr, byte[] src, int srcOff, int srcLen,
                                              byte[] dest, int destOff, int maxDestLen);
+    static native int decompressDirect(long decompressorPtr, ByteBuffer src, int srcPos, int srcLen,
+                                       ByteBuffer dest, int destPos, int maxDestLen);
     
     static native byte[] decompressNumeric(long decompressorPtr, byte[] src, int elementSize, int expectedCount);
     static native int[] decompressNumericInts(long decompressorPtr, byte[] src);
     static native long[] decompressNumericLongs(long decompressorPtr, byte[] src);
     static native float[] decompressNumericFloats(long decompressorPtr, byte[] src);
     static native double[] decompressNumericDoubles(long decompressorPtr, byte[] src);
+    static native int decompressNumericIntsInto(long decompressorPtr, byte[] src, int srcOff, int srcLen,
+                                                int[] dest, int destOff);
+    static native int decompressNumericLongsInto(long decompressorPtr, byte[] src, int srcOff, int srcLen,
+                                                 long[] dest, int destOff);
+    static native int decompressNumericFloatsInto(long decompressorPtr, byte[] src, int srcOff, int srcLen,
+                                                  float[] dest, int destOff);
+    static native int decompressNumericDoublesInto(long decompressorPtr, byte[] src, int srcOff, int srcLen,
+                                                   double[] dest, int destOff);
     
     static native CompressionInfo getCompressionInfo(byte[] src);
-    static native int compressBound(int srcLen);
+    static native long compressBound(long srcLen);
+    static native int currentCpu();
+    static native byte[] compressBatch(long compressorPtr, Object[] srcs, int[] srcOffs, int[] srcLens,
+                                       int[] destOffsets);
+    static native byte[][] decompressBatch(long decompressorPtr, byte[] src, int[] srcOffsets);
+    
+    static native long compressParallel(int graphId, long srcAddress, long srcSize, long destAddress,
+                                        long destCapacity, int blockSize, int threads);
+    static native long decompressParallel(long srcAddress, long srcSize, long destAddress, long destCapacity,
+                                          long[] frameOffsets, int[] compressedSizes, long[] rawOffsets,
+                                          int[] rawSizes, int threads);
+    static native long[] scanFrames(long srcAddress, long srcSize);
+    static native long[] scanFramesArray(byte[] src, int srcOff, int srcLen);
+    static native long compressFile(byte[] srcPath, byte[] destPath, int graphId, int blockSize, int threads,
+                                    boolean dropCache, boolean ioUring) throws IOException;
+    static native long decompressFile(byte[] srcPath, byte[] destPath, int threads, boolean dropCache)
+            throws IOException;
+    static native boolean ioUringAvailable();
     
     private OpenZLJNI() {
     }
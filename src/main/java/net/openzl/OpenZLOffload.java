@@ -0,0 +1,107 @@
+package net.openzl;
+
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.Supplier;
+
+/**
+ * Hands large native calls made on virtual threads to a small pool of platform threads.
+ *
+ * A native frame pins a virtual thread to its carrier for the whole call, so a handful of
+ * multi-megabyte compressions can occupy every carrier. Offloaded, the virtual thread
+ * parks in join() and its carrier keeps running other virtual threads. Calls below the
+ * threshold stay on the caller, where the pinning is shorter than the handoff.
+ *
+ * MemorySegment overloads are never offloaded: a confined segment can only be accessed
+ * from the thread that owns it.
+ */
+final class OpenZLOffload {
+    
+    static final String THRESHOLD_PROPERTY = "openzl.virtualThreadOffloadThreshold";
+    static final String THREADS_PROPERTY = "openzl.offloadThreads";
+    static final int DEFAULT_THRESHOLD = 256 * 1024;
+    
+    private static volatile int threshold = Integer.getInteger(THRESHOLD_PROPERTY, DEFAULT_THRESHOLD);
+    
+    /**
+     * A call that may fail with an IOException, for callIO.
+     */
+    interface IOCall<T> {
+        T run() throws IOException;
+    }
+    
+    private OpenZLOffload() {
+    }
+    
+    private static final class Pool {
+        static final ExecutorService EXECUTOR = create();
+        
+        private static ExecutorService create() {
+            int threads = Integer.getInteger(THREADS_PROPERTY,
+                    Math.max(2, Runtime.getRuntime().availableProcessors() / 2));
+            AtomicInteger count = new AtomicInteger();
+            return Executors.newFixedThreadPool(Math.max(1, threads), task -> {
+                Thread thread = new Thread(task, "openzl-offload-" + count.incrementAndGet());
+                thread.setDaemon(true);
+                return thread;
+            });
+        }
+    }
+    
+    /**
+     * Sets the size in bytes from which virtual-thread calls are offloaded; negative disables.
+     */
+    static void setThreshold(int bytes) {
+        threshold = bytes;
+    }
+    
+    static int getThreshold() {
+        return threshold;
+    }
+    
+    static boolean shouldOffload(long bytes) {
+        int limit = threshold;
+        return limit >= 0 && bytes >= limit && Thread.currentThread().isVirtual();
+    }
+    
+    /**
+     * Runs action on an offload thread and parks the caller until it completes, rethrowing
+     * its exception unchanged.
+     */
+    static <T> T call(Supplier<T> action) {
+        try {
+            return CompletableFuture.supplyAsync(action, Pool.EXECUTOR).join();
+        } catch (CompletionException e) {
+            Throwable cause = e.getCause();
+            if (cause instanceof RuntimeException runtime) {
+                throw runtime;
+            }
+            if (cause instanceof Error error) {
+                throw error;
+            }
+            throw new OpenZLException("Offloaded call failed", cause);
+        }
+    }
+    
+    /**
+     * Like call, for actions that throw IOException; the exception is rethrown unchanged.
+     */
+    static <T> T callIO(IOCall<T> action) throws IOException {
+        try {
+            return call(() -> {
+                try {
+                    return action.run();
+                } catch (IOException e) {
+                    throw new UncheckedIOException(e);
+                }
+            });
+        } catch (UncheckedIOException e) {
+            throw e.getCause();
+        }
+    }
+}
\ No newline at end of file
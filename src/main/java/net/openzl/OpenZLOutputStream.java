@@ -0,0 +1,186 @@
+package net.openzl;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.lang.foreign.MemorySegment;
+import java.util.Arrays;
+import java.util.Objects;
+
+/**
+ * Compresses a byte stream into a block container (see OpenZLFrameFormat) without holding
+ * the payload in memory. Writes are gathered into blocks of blockSize bytes, and each
+ * block is compressed with one reused compressor and written as a length-prefixed frame.
+ * Memory is the block buffer plus one worst-case frame buffer, about 2 * blockSize, however
+ * much is written.
+ *
+ * finish() or close() writes the end marker and the block index, so the output can also be
+ * read by OpenZLParallel and the seekable reader. flush() compresses a partial block.
+ * Not thread-safe.
+ */
+public final class OpenZLOutputStream extends OutputStream {
+    
+    private final OutputStream out;
+    private final OpenZLCompressor compressor;
+    private final int blockSize;
+    private final byte[] block;
+    private final byte[] frame;
+    private int pending;
+    private long position;
+    private int count;
+    private long[] frameOffsets = new long[16];
+    private int[] compressedSizes = new int[16];
+    private int[] rawSizes = new int[16];
+    private boolean finished = false;
+    private boolean closed = false;
+    
+    public OpenZLOutputStream(OutputStream out) throws IOException {
+        this(out, CompressionGraph.ZSTD, OpenZLFrameFormat.DEFAULT_BLOCK_SIZE);
+    }
+    
+    public OpenZLOutputStream(OutputStream out, CompressionGraph graph, int blockSize) throws IOException {
+        if (out == null) {
+            throw new IllegalArgumentException("Output stream cannot be null");
+        }
+        if (graph == null) {
+            throw new IllegalArgumentException("Compression graph cannot be null");
+        }
+        OpenZLFrameFormat.checkBlockSize(blockSize);
+        this.out = out;
+        this.blockSize = blockSize;
+        this.block = new byte[blockSize];
+        this.frame = new byte[OpenZLFrameFormat.BLOCK_HEADER_SIZE + OpenZLCompressor.maxCompressedLength(blockSize)];
+        this.compressor = OpenZLFactory.compressor(graph);
+        
+        try {
+            OpenZLFrameFormat.writeHeader(MemorySegment.ofArray(frame), 0, OpenZLFrameFormat.FLAG_INDEXED, blockSize);
+            out.write(frame, 0, OpenZLFrameFormat.HEADER_SIZE);
+        } catch (IOException | RuntimeException e) {
+            compressor.close();
+            throw e;
+        }
+        this.position = OpenZLFrameFormat.HEADER_SIZE;
+    }
+    
+    @Override
+    public void write(int b) throws IOException {
+        ensureOpen();
+        block[pending++] = (byte) b;
+        if (pending == blockSize) {
+            writeBlock(block, 0, pending);
+            pending = 0;
+        }
+    }
+    
+    /**
+     * Full blocks of b are compressed in place when nothing is pending, so large writes skip
+     * the copy into the block buffer.
+     */
+    @Override
+    public void write(byte[] b, int off, int len) throws IOException {
+        Objects.checkFromIndexSize(off, len, b.length);
+        ensureOpen();
+        while (len > 0) {
+            if (pending == 0 && len >= blockSize) {
+                writeBlock(b, off, blockSize);
+                off += blockSize;
+                len -= blockSize;
+                continue;
+            }
+            int n = Math.min(len, blockSize - pending);
+            System.arraycopy(b, off, block, pending, n);
+            pending += n;
+            off += n;
+            len -= n;
+            if (pending == blockSize) {
+                writeBlock(block, 0, pending);
+                pending = 0;
+            }
+        }
+    }
+    
+    /**
+     * Compresses any pending bytes as a short block and flushes the underlying stream.
+     */
+    @Override
+    public void flush() throws IOException {
+        ensureOpen();
+        if (pending > 0) {
+            writeBlock(block, 0, pending);
+            pending = 0;
+        }
+        out.flush();
+    }
+    
+    /**
+     * Writes the last block, the end marker and the index without closing the underlying
+     * stream, and releases the compressor. Further writes fail.
+     */
+    public void finish() throws IOException {
+        if (finished) {
+            return;
+        }
+        try {
+            if (pending > 0) {
+                writeBlock(block, 0, pending);
+                pending = 0;
+            }
+            byte[] footer = new byte[OpenZLFrameFormat.END_MARKER_SIZE + OpenZLFrameFormat.indexSize(count)];
+            OpenZLFrameFormat.writeFooter(MemorySegment.ofArray(footer), 0, position, new OpenZLFrameFormat.BlockTable(
+                    blockSize, count, frameOffsets, compressedSizes, rawSizes, 0));
+            out.write(footer);
+            position += footer.length;
+        } finally {
+            finished = true;
+            compressor.close();
+        }
+    }
+    
+    @Override
+    public void close() throws IOException {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        try {
+            finish();
+        } finally {
+            out.close();
+        }
+    }
+    
+    /**
+     * Bytes written to the underlying stream so far.
+     */
+    public long getCompressedSize() {
+        return position;
+    }
+    
+    public int getBlockSize() {
+        return blockSize;
+    }
+    
+    private void writeBlock(byte[] src, int off, int len) throws IOException {
+        int compressed = compressor.compress(src, off, len, frame, OpenZLFrameFormat.BLOCK_HEADER_SIZE,
+                frame.length - OpenZLFrameFormat.BLOCK_HEADER_SIZE);
+        OpenZLFrameFormat.writeBlockHeader(MemorySegment.ofArray(frame), 0, compressed, len);
+        
+        if (count == frameOffsets.length) {
+            frameOffsets = Arrays.copyOf(frameOffsets, count * 2);
+            compressedSizes = Arrays.copyOf(compressedSizes, count * 2);
+            rawSizes = Arrays.copyOf(rawSizes, count * 2);
+        }
+        frameOffsets[count] = position + OpenZLFrameFormat.BLOCK_HEADER_SIZE;
+        compressedSizes[count] = compressed;
+        rawSizes[count] = len;
+        count++;
+        
+        out.write(frame, 0, OpenZLFrameFormat.BLOCK_HEADER_SIZE + compressed);
+        position += OpenZLFrameFormat.BLOCK_HEADER_SIZE + compressed;
+    }
+    
+    private void ensureOpen() throws IOException {
+        if (finished) {
+            throw new IOException(closed ? "Stream closed" : "Stream finished");
+        }
+    }
+}
@@ -0,0 +1,365 @@
+package net.openzl;
+
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.ref.Reference;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Objects;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.RecursiveAction;
+
+/**
+ * Compresses large inputs on all cores by splitting them into independently compressed
+ * blocks, and decompresses the resulting block container (see OpenZLFrameFormat) with the
+ * blocks decoded concurrently.
+ *
+ * Blocks run as ForkJoinPool tasks. Contexts come from OpenZLPool.shared(), whose
+ * per-thread slot pins one ZL_CCtx / ZL_DCtx to each worker, so a steady workload creates
+ * exactly one context per worker. Instances are thread-safe.
+ *
+ * The MemorySegment overloads instead run the whole job inside one JNI call on the native
+ * library's own work-stealing workers, which makes small blocks (64 KB and up) worthwhile;
+ * they use at most pool.getParallelism() of those workers. The native pool is shared by
+ * the whole process: concurrent jobs run side by side on disjoint workers, each starting
+ * once as many are idle as it uses, so jobs that each use every worker run one at a time.
+ * These calls hand the segments' raw addresses to native code: the segments are kept
+ * reachable for the call, but the arenas they belong to must not be closed while it runs.
+ *
+ * Every decompress method also accepts a plain run of concatenated OpenZL frames, such as
+ * repeated OpenZLCompressor output. Frame boundaries are then found natively with
+ * ZL_getCompressedSize, which reads only frame headers, and the frames are decoded
+ * concurrently into their final offsets just like container blocks.
+ */
+public final class OpenZLParallel {
+    
+    static {
+        OpenZLJNI.init();
+    }
+    
+    private final CompressionGraph graph;
+    private final int blockSize;
+    private final ForkJoinPool pool;
+    
+    public OpenZLParallel() {
+        this(CompressionGraph.ZSTD, OpenZLFrameFormat.DEFAULT_BLOCK_SIZE, ForkJoinPool.commonPool());
+    }
+    
+    public OpenZLParallel(CompressionGraph graph, int blockSize, ForkJoinPool pool) {
+        if (graph == null || pool == null) {
+            throw new IllegalArgumentException("Compression graph and pool cannot be null");
+        }
+        OpenZLFrameFormat.checkBlockSize(blockSize);
+        this.graph = graph;
+        this.blockSize = blockSize;
+        this.pool = pool;
+    }
+    
+    public byte[] compress(byte[] src) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        return compress(src, 0, src.length);
+    }
+    
+    public byte[] compress(byte[] src, int srcOff, int srcLen) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        Objects.checkFromIndexSize(srcOff, srcLen, src.length);
+        
+        int count = (int) (((long) srcLen + blockSize - 1) / blockSize);
+        byte[][] frames = new byte[count][];
+        pool.invoke(new BlockAction(0, count, i -> {
+            int off = i * blockSize;
+            int len = Math.min(blockSize, srcLen - off);
+            OpenZLCompressor compressor = OpenZLPool.shared().borrowCompressor(graph);
+            try {
+                frames[i] = compressor.compress(src, srcOff + off, len);
+            } finally {
+                OpenZLPool.shared().release(compressor);
+            }
+        }));
+        
+        long[] frameOffsets = new long[count];
+        int[] compressedSizes = new int[count];
+        int[] rawSizes = new int[count];
+        long pos = OpenZLFrameFormat.HEADER_SIZE;
+        for (int i = 0; i < count; i++) {
+            frameOffsets[i] = pos + OpenZLFrameFormat.BLOCK_HEADER_SIZE;
+            compressedSizes[i] = frames[i].length;
+            rawSizes[i] = Math.min(blockSize, srcLen - i * blockSize);
+            pos = frameOffsets[i] + frames[i].length;
+        }
+        long total = pos + OpenZLFrameFormat.END_MARKER_SIZE + OpenZLFrameFormat.indexSize(count);
+        if (total > Integer.MAX_VALUE - 8) {
+            throw new OpenZLException("Compressed container exceeds the maximum array size: " + total);
+        }
+        
+        byte[] out = new byte[(int) total];
+        MemorySegment dest = MemorySegment.ofArray(out);
+        OpenZLFrameFormat.writeHeader(dest, 0, OpenZLFrameFormat.FLAG_INDEXED, blockSize);
+        for (int i = 0; i < count; i++) {
+            OpenZLFrameFormat.writeBlockHeader(dest, frameOffsets[i] - OpenZLFrameFormat.BLOCK_HEADER_SIZE,
+                    compressedSizes[i], rawSizes[i]);
+            System.arraycopy(frames[i], 0, out, (int) frameOffsets[i], frames[i].length);
+        }
+        OpenZLFrameFormat.writeFooter(dest, pos, new OpenZLFrameFormat.BlockTable(
+                blockSize, count, frameOffsets, compressedSizes, rawSizes, total));
+        return out;
+    }
+    
+    public byte[] decompress(byte[] src) {
+        if (src == null) {
+            throw new IllegalArgumentException("Source array cannot be null");
+        }
+        
+        OpenZLFrameFormat.BlockTable table = blockTable(MemorySegment.ofArray(src));
+        if (table.rawSize > Integer.MAX_VALUE - 8) {
+            throw new OpenZLException("Decompressed size exceeds the maximum array size: " + table.rawSize);
+        }
+        
+        byte[] out = new byte[(int) table.rawSize];
+        pool.invoke(new BlockAction(0, table.count, i -> {
+            OpenZLDecompressor decompressor = OpenZLPool.shared().borrowDecompressor();
+            try {
+                int written = decompressor.decompress(src, (int) table.frameOffsets[i], table.compressedSizes[i],
+                        out, (int) table.rawOffsets[i], table.rawSizes[i]);
+                if (written != table.rawSizes[i]) {
+                    throw new OpenZLException("Block " + i + " decompressed to " + written
+                            + " bytes, expected " + table.rawSizes[i]);
+                }
+            } finally {
+                OpenZLPool.shared().release(decompressor);
+            }
+        }));
+        return out;
+    }
+    
+    /**
+     * Compresses src into an indexed block container at the start of dest with a single
+     * native call. dest must hold maxCompressedLength(src.byteSize(), getBlockSize()) bytes.
+     * Returns the container size.
+     */
+    public long compress(MemorySegment src, MemorySegment dest) {
+        if (src == null || dest == null) {
+            throw new IllegalArgumentException("Source and destination segments cannot be null");
+        }
+        if (dest.isReadOnly()) {
+            throw new IllegalArgumentException("Destination segment is read-only");
+        }
+        long bound = maxCompressedLength(src.byteSize(), blockSize);
+        if (dest.byteSize() < bound) {
+            throw new IllegalArgumentException("Destination segment too small: " + dest.byteSize() + " < " + bound);
+        }
+        if (src.isNative() && dest.isNative()) {
+            return compressNative(src, dest);
+        }
+        
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment nativeSrc = src.isNative() ? src : arena.allocate(src.byteSize()).copyFrom(src);
+            MemorySegment nativeDest = dest.isNative() ? dest : arena.allocate(bound);
+            long written = compressNative(nativeSrc, nativeDest);
+            if (nativeDest != dest) {
+                MemorySegment.copy(nativeDest, 0, dest, 0, written);
+            }
+            return written;
+        }
+    }
+    
+    public MemorySegment compress(MemorySegment src, Arena arena) {
+        if (src == null || arena == null) {
+            throw new IllegalArgumentException("Source segment and arena cannot be null");
+        }
+        MemorySegment dest = arena.allocate(maxCompressedLength(src.byteSize(), blockSize));
+        return dest.asSlice(0, compress(src, dest));
+    }
+    
+    /**
+     * Decodes the container or frame run in src into dest with a single native call, every
+     * block going straight to its final offset. Returns the number of bytes written.
+     */
+    public long decompress(MemorySegment src, MemorySegment dest) {
+        if (src == null || dest == null) {
+            throw new IllegalArgumentException("Source and destination segments cannot be null");
+        }
+        if (dest.isReadOnly()) {
+            throw new IllegalArgumentException("Destination segment is read-only");
+        }
+        
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment nativeSrc = src.isNative() ? src : arena.allocate(src.byteSize()).copyFrom(src);
+            OpenZLFrameFormat.BlockTable table = blockTable(nativeSrc);
+            if (dest.byteSize() < table.rawSize) {
+                throw new IllegalArgumentException("Destination segment too small: " + dest.byteSize() + " < " + table.rawSize);
+            }
+            MemorySegment nativeDest = dest.isNative() ? dest : arena.allocate(table.rawSize);
+            long written = decompressNative(table, nativeSrc, nativeDest);
+            if (nativeDest != dest) {
+                MemorySegment.copy(nativeDest, 0, dest, 0, written);
+            }
+            return written;
+        }
+    }
+    
+    public MemorySegment decompress(MemorySegment src, Arena arena) {
+        if (src == null || arena == null) {
+            throw new IllegalArgumentException("Source segment and arena cannot be null");
+        }
+        try (Arena staging = Arena.ofConfined()) {
+            MemorySegment nativeSrc = src.isNative() ? src : staging.allocate(src.byteSize()).copyFrom(src);
+            OpenZLFrameFormat.BlockTable table = blockTable(nativeSrc);
+            MemorySegment dest = arena.allocate(table.rawSize);
+            return dest.asSlice(0, decompressNative(table, nativeSrc, dest));
+        }
+    }
+    
+    /**
+     * Decodes a container or frame run file into dest, which is created or truncated and
+     * sized up front; both files are memory-mapped, so every block is written straight to
+     * its final file offset by the native workers. dest must not be src, and is deleted if
+     * decoding fails. Returns the decompressed size.
+     */
+    public long decompress(Path src, Path dest) throws IOException {
+        if (src == null || dest == null) {
+            throw new IllegalArgumentException("Source and destination paths cannot be null");
+        }
+        OpenZLFiles.checkDistinct(src, dest);
+        try (FileChannel in = FileChannel.open(src, StandardOpenOption.READ)) {
+            FileChannel out = FileChannel.open(dest, StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING,
+                    StandardOpenOption.READ, StandardOpenOption.WRITE);
+            try (out; Arena arena = Arena.ofConfined()) {
+                MemorySegment input = in.map(FileChannel.MapMode.READ_ONLY, 0, in.size(), arena);
+                OpenZLFrameFormat.BlockTable table = blockTable(input);
+                if (table.rawSize == 0) {
+                    return 0;
+                }
+                MemorySegment output = out.map(FileChannel.MapMode.READ_WRITE, 0, table.rawSize, arena);
+                return decompressNative(table, input, output);
+            } catch (IOException | RuntimeException e) {
+                OpenZLFiles.discard(dest, e);
+                throw e;
+            }
+        }
+    }
+    
+    /**
+     * Block table of a container, or of a plain frame run located with ZL_getCompressedSize.
+     * src must be native or backed by a byte[].
+     */
+    private static OpenZLFrameFormat.BlockTable blockTable(MemorySegment src) {
+        if (OpenZLFrameFormat.isContainer(src)) {
+            return OpenZLFrameFormat.readBlockTable(src);
+        }
+        long[] frames;
+        if (src.isNative()) {
+            try {
+                frames = OpenZLJNI.scanFrames(src.address(), src.byteSize());
+            } finally {
+                Reference.reachabilityFence(src);
+            }
+        } else {
+            frames = OpenZLJNI.scanFramesArray((byte[]) src.heapBase().orElseThrow(), (int) src.address(),
+                    (int) src.byteSize());
+        }
+        return OpenZLFrameFormat.frameTable(frames, src.byteSize());
+    }
+    
+    /**
+     * The JNI calls below take bare addresses, so the fences keep an automatic arena's
+     * segments from being freed before native code is done with them. A segment whose arena
+     * is already closed is rejected here rather than read after free.
+     */
+    private long compressNative(MemorySegment src, MemorySegment dest) {
+        checkAlive(src, dest);
+        try {
+            return OpenZLJNI.compressParallel(graph.getId(), src.address(), src.byteSize(), dest.address(),
+                    dest.byteSize(), blockSize, pool.getParallelism());
+        } finally {
+            Reference.reachabilityFence(src);
+            Reference.reachabilityFence(dest);
+        }
+    }
+    
+    private long decompressNative(OpenZLFrameFormat.BlockTable table, MemorySegment src, MemorySegment dest) {
+        checkAlive(src, dest);
+        try {
+            return OpenZLJNI.decompressParallel(src.address(), src.byteSize(), dest.address(), dest.byteSize(),
+                    table.frameOffsets, table.compressedSizes, table.rawOffsets, table.rawSizes,
+                    pool.getParallelism());
+        } finally {
+            Reference.reachabilityFence(src);
+            Reference.reachabilityFence(dest);
+        }
+    }
+    
+    private static void checkAlive(MemorySegment src, MemorySegment dest) {
+        if (!src.scope().isAlive() || !dest.scope().isAlive()) {
+            throw new IllegalStateException("Segment arena has already been closed");
+        }
+    }
+    
+    /**
+     * Destination size the native compress(MemorySegment, ...) overloads require: every
+     * block in a worst-case slot, plus the end marker, index and trailer.
+     */
+    public static long maxCompressedLength(long srcSize, int blockSize) {
+        if (srcSize < 0) {
+            throw new IllegalArgumentException("Source size cannot be negative");
+        }
+        OpenZLFrameFormat.checkBlockSize(blockSize);
+        long count = (srcSize + blockSize - 1) / blockSize;
+        long perBlock = OpenZLFrameFormat.BLOCK_HEADER_SIZE + OpenZLJNI.compressBound(blockSize)
+                + OpenZLFrameFormat.INDEX_ENTRY_SIZE;
+        return OpenZLFrameFormat.HEADER_SIZE + count * perBlock + OpenZLFrameFormat.END_MARKER_SIZE
+                + OpenZLFrameFormat.TRAILER_SIZE;
+    }
+    
+    /**
+     * Returns true if data starts with a block container header.
+     */
+    public static boolean isContainer(byte[] data) {
+        return data != null && OpenZLFrameFormat.isContainer(MemorySegment.ofArray(data));
+    }
+    
+    public CompressionGraph getGraph() {
+        return graph;
+    }
+    
+    public int getBlockSize() {
+        return blockSize;
+    }
+    
+    interface BlockTask {
+        void run(int block);
+    }
+    
+    /**
+     * Splits [from, to) in halves until single blocks remain, so idle workers steal large ranges.
+     */
+    static final class BlockAction extends RecursiveAction {
+        private final int from;
+        private final int to;
+        private final BlockTask task;
+        
+        BlockAction(int from, int to, BlockTask task) {
+            this.from = from;
+            this.to = to;
+            this.task = task;
+        }
+        
+        @Override
+        protected void compute() {
+            if (to - from <= 1) {
+                if (to > from) {
+                    task.run(from);
+                }
+                return;
+            }
+            int mid = (from + to) >>> 1;
+            invokeAll(new BlockAction(from, mid, task), new BlockAction(mid, to, task));
+        }
+    }
+}
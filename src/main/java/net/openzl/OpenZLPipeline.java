@@ -0,0 +1,482 @@
+package net.openzl;
+
+import java.io.EOFException;
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.ReadableByteChannel;
+import java.nio.channels.WritableByteChannel;
+import java.util.Arrays;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicReference;
+
+/**
+ * Streams a channel through read, compress and write stages that run concurrently, so
+ * disk or network I/O overlaps with compression. The calling thread reads blocks, N worker
+ * threads compress them with their own OpenZLCompressor, and a writer thread emits them in
+ * input order as an indexed block container (see OpenZLFrameFormat). decompress() runs the
+ * same stages over a container.
+ *
+ * Blocks travel in a fixed ring of slots, each an input and an output buffer. The ring
+ * holds up to 2 * workers + 2 slots, so every worker has its next block queued while the
+ * reader and the writer each hold one, but never more than RING_BYTES of buffers, and
+ * never fewer than three slots, which still overlaps reading, compressing and writing.
+ * The buffers come from an arena that each call frees before returning, so memory is
+ * bounded by the ring whatever the stream length and however often the pipeline runs.
+ *
+ * Instances keep no threads between calls and are thread-safe. Channels must be blocking
+ * and are not closed.
+ */
+public final class OpenZLPipeline {
+    
+    static {
+        OpenZLJNI.init();
+    }
+    
+    private static final long POLL_MS = 50;
+    static final long RING_BYTES = 64L * 1024 * 1024;
+    private static final int MIN_SLOTS = 3;
+    
+    private final CompressionGraph graph;
+    private final int blockSize;
+    private final int workers;
+    
+    public OpenZLPipeline() {
+        this(CompressionGraph.ZSTD, OpenZLFrameFormat.DEFAULT_BLOCK_SIZE, Runtime.getRuntime().availableProcessors());
+    }
+    
+    public OpenZLPipeline(CompressionGraph graph, int blockSize, int workers) {
+        if (graph == null) {
+            throw new IllegalArgumentException("Compression graph cannot be null");
+        }
+        if (workers <= 0) {
+            throw new IllegalArgumentException("Worker count must be positive");
+        }
+        OpenZLFrameFormat.checkBlockSize(blockSize);
+        this.graph = graph;
+        this.blockSize = blockSize;
+        this.workers = workers;
+    }
+    
+    /**
+     * Compresses everything readable from in into an indexed block container on out.
+     * Returns the number of bytes written.
+     */
+    public long compress(ReadableByteChannel in, WritableByteChannel out) throws IOException {
+        if (in == null || out == null) {
+            throw new IllegalArgumentException("Source and destination channels cannot be null");
+        }
+        return new CompressJob(in, out).run(blockSize,
+                OpenZLFrameFormat.BLOCK_HEADER_SIZE + OpenZLCompressor.maxCompressedLength(blockSize));
+    }
+    
+    /**
+     * Decompresses a block container read from in, as written by compress() or
+     * OpenZLParallel, onto out. Returns the number of bytes written.
+     */
+    public long decompress(ReadableByteChannel in, WritableByteChannel out) throws IOException {
+        if (in == null || out == null) {
+            throw new IllegalArgumentException("Source and destination channels cannot be null");
+        }
+        ByteBuffer header = ByteBuffer.allocate(OpenZLFrameFormat.HEADER_SIZE);
+        if (!readFully(in, header)) {
+            throw new EOFException("Truncated OpenZL block container header");
+        }
+        MemorySegment segment = MemorySegment.ofArray(header.array());
+        if (!OpenZLFrameFormat.isContainer(segment)) {
+            throw new OpenZLException("Not an OpenZL block container");
+        }
+        int version = segment.get(OpenZLFrameFormat.INT, 4) & 0xFF;
+        if (version != OpenZLFrameFormat.VERSION) {
+            throw new OpenZLException("Unsupported block container version: " + version);
+        }
+        int containerBlockSize = segment.get(OpenZLFrameFormat.INT, 8);
+        OpenZLFrameFormat.checkBlockSize(containerBlockSize);
+        return new DecompressJob(in, out, containerBlockSize).run(
+                OpenZLCompressor.maxCompressedLength(containerBlockSize), containerBlockSize);
+    }
+    
+    public CompressionGraph getGraph() {
+        return graph;
+    }
+    
+    public int getBlockSize() {
+        return blockSize;
+    }
+    
+    public int getWorkers() {
+        return workers;
+    }
+    
+    /**
+     * Reads until buffer is full or the channel ends; returns whether it filled. The buffer
+     * is left flipped for reading.
+     */
+    private static boolean readFully(ReadableByteChannel in, ByteBuffer buffer) throws IOException {
+        while (buffer.hasRemaining()) {
+            if (in.read(buffer) < 0) {
+                break;
+            }
+        }
+        boolean full = !buffer.hasRemaining();
+        buffer.flip();
+        return full;
+    }
+    
+    private static void writeFully(WritableByteChannel out, ByteBuffer buffer) throws IOException {
+        while (buffer.hasRemaining()) {
+            out.write(buffer);
+        }
+    }
+    
+    /**
+     * One block in flight. The worker releases done once output holds the result, which is
+     * what the writer waits for.
+     */
+    private static final class Slot {
+        static final Slot END = new Slot(null, null);
+        
+        final ByteBuffer input;
+        final ByteBuffer output;
+        final Semaphore done = new Semaphore(0);
+        int rawSize;
+        int compressedSize;
+        
+        Slot(ByteBuffer input, ByteBuffer output) {
+            this.input = input;
+            this.output = output;
+        }
+    }
+    
+    /**
+     * Runs the three stages for one call. Slots circulate free -> worker -> writer -> free;
+     * the order queue hands them to the writer in the sequence the reader filled them. A
+     * failing stage records the first error and the others notice within POLL_MS.
+     */
+    private abstract class Job<C extends AutoCloseable> {
+        final ReadableByteChannel in;
+        final WritableByteChannel out;
+        final AtomicReference<Throwable> failure = new AtomicReference<>();
+        long written;
+        
+        Job(ReadableByteChannel in, WritableByteChannel out) {
+            this.in = in;
+            this.out = out;
+        }
+        
+        abstract C open();
+        
+        /** Fills slot.input with the next block; returns false at the end of the input. */
+        abstract boolean read(Slot slot) throws IOException;
+        
+        abstract void process(C codec, Slot slot);
+        
+        abstract void write(Slot slot) throws IOException;
+        
+        abstract void finish() throws IOException;
+        
+        long run(int inputCapacity, int outputCapacity) throws IOException {
+            long slotBytes = (long) inputCapacity + outputCapacity;
+            int slotCount = (int) Math.max(MIN_SLOTS, Math.min(2L * workers + 2, RING_BYTES / slotBytes));
+            try (Arena arena = Arena.ofShared()) {
+                return run(arena, slotCount, inputCapacity, outputCapacity);
+            }
+        }
+        
+        /**
+         * Every stage thread has been joined by the time this returns or throws, so the
+         * caller can free the arena the slots live in.
+         */
+        private long run(Arena arena, int slotCount, int inputCapacity, int outputCapacity) throws IOException {
+            BlockingQueue<Slot> free = new ArrayBlockingQueue<>(slotCount);
+            BlockingQueue<Slot> work = new ArrayBlockingQueue<>(slotCount + workers);
+            BlockingQueue<Slot> order = new ArrayBlockingQueue<>(slotCount + 1);
+            for (int i = 0; i < slotCount; i++) {
+                free.add(new Slot(arena.allocate(inputCapacity).asByteBuffer().order(ByteOrder.LITTLE_ENDIAN),
+                        arena.allocate(outputCapacity).asByteBuffer().order(ByteOrder.LITTLE_ENDIAN)));
+            }
+            
+            Thread[] threads = new Thread[workers + 1];
+            for (int i = 0; i < workers; i++) {
+                threads[i] = new Thread(() -> guard(() -> serve(work)), "openzl-pipeline-worker-" + i);
+            }
+            threads[workers] = new Thread(() -> guard(() -> drain(order, free)), "openzl-pipeline-writer");
+            for (Thread thread : threads) {
+                thread.setDaemon(true);
+                thread.start();
+            }
+            
+            guard(() -> {
+                while (true) {
+                    Slot slot = take(free);
+                    if (slot == null) {
+                        return;
+                    }
+                    if (!read(slot)) {
+                        break;
+                    }
+                    order.add(slot);
+                    work.add(slot);
+                }
+            });
+            for (int i = 0; i < workers; i++) {
+                work.add(Slot.END);
+            }
+            order.add(Slot.END);
+            
+            boolean interrupted = false;
+            for (Thread thread : threads) {
+                while (true) {
+                    try {
+                        thread.join();
+                        break;
+                    } catch (InterruptedException e) {
+                        interrupted = true;
+                        fail(new InterruptedIOException("Interrupted while waiting for the pipeline"));
+                    }
+                }
+            }
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+            }
+            
+            Throwable error = failure.get();
+            if (error instanceof InterruptedException) {
+                Thread.currentThread().interrupt();
+                throw new InterruptedIOException("Interrupted while reading the pipeline input");
+            }
+            if (error instanceof IOException io) {
+                throw io;
+            }
+            if (error instanceof RuntimeException runtime) {
+                throw runtime;
+            }
+            if (error instanceof Error fatal) {
+                throw fatal;
+            }
+            if (error != null) {
+                throw new OpenZLException("Pipeline stage failed", error);
+            }
+            return written;
+        }
+        
+        private void serve(BlockingQueue<Slot> work) {
+            try (C codec = open()) {
+                while (true) {
+                    Slot slot = take(work);
+                    if (slot == null || slot == Slot.END) {
+                        return;
+                    }
+                    try {
+                        process(codec, slot);
+                    } catch (RuntimeException | Error e) {
+                        // Record the failure before waking the writer, or it would write the slot.
+                        fail(e);
+                        slot.done.release();
+                        throw e;
+                    }
+                    slot.done.release();
+                }
+            } catch (Exception e) {
+                fail(e);
+            }
+        }
+        
+        private void drain(BlockingQueue<Slot> order, BlockingQueue<Slot> free) throws Exception {
+            while (true) {
+                Slot slot = take(order);
+                if (slot == null) {
+                    return;
+                }
+                if (slot == Slot.END) {
+                    finish();
+                    return;
+                }
+                while (!slot.done.tryAcquire(POLL_MS, TimeUnit.MILLISECONDS)) {
+                    if (failure.get() != null) {
+                        return;
+                    }
+                }
+                if (failure.get() != null) {
+                    return;
+                }
+                write(slot);
+                free.add(slot);
+            }
+        }
+        
+        /**
+         * Takes the next slot, or returns null once another stage has failed.
+         */
+        private Slot take(BlockingQueue<Slot> queue) throws InterruptedException {
+            while (failure.get() == null) {
+                Slot slot = queue.poll(POLL_MS, TimeUnit.MILLISECONDS);
+                if (slot != null) {
+                    return slot;
+                }
+            }
+            return null;
+        }
+        
+        private void guard(Stage stage) {
+            try {
+                stage.run();
+            } catch (Throwable t) {
+                fail(t);
+            }
+        }
+        
+        private void fail(Throwable t) {
+            failure.compareAndSet(null, t);
+        }
+    }
+    
+    @FunctionalInterface
+    private interface Stage {
+        void run() throws Exception;
+    }
+    
+    private final class CompressJob extends Job<OpenZLCompressor> {
+        private long position;
+        private int count;
+        private long[] frameOffsets = new long[16];
+        private int[] compressedSizes = new int[16];
+        private int[] rawSizes = new int[16];
+        
+        CompressJob(ReadableByteChannel in, WritableByteChannel out) {
+            super(in, out);
+        }
+        
+        @Override
+        OpenZLCompressor open() {
+            return OpenZLFactory.compressor(graph);
+        }
+        
+        @Override
+        boolean read(Slot slot) throws IOException {
+            slot.input.clear().limit(blockSize);
+            readFully(in, slot.input);
+            return slot.input.hasRemaining();
+        }
+        
+        @Override
+        void process(OpenZLCompressor compressor, Slot slot) {
+            slot.rawSize = slot.input.remaining();
+            slot.output.clear().position(OpenZLFrameFormat.BLOCK_HEADER_SIZE);
+            slot.compressedSize = compressor.compress(slot.input, slot.output);
+            slot.output.putInt(0, slot.compressedSize);
+            slot.output.putInt(4, slot.rawSize);
+            slot.output.flip();
+        }
+        
+        @Override
+        void write(Slot slot) throws IOException {
+            writeHeaderOnce();
+            if (count == frameOffsets.length) {
+                frameOffsets = Arrays.copyOf(frameOffsets, count * 2);
+                compressedSizes = Arrays.copyOf(compressedSizes, count * 2);
+                rawSizes = Arrays.copyOf(rawSizes, count * 2);
+            }
+            frameOffsets[count] = position + OpenZLFrameFormat.BLOCK_HEADER_SIZE;
+            compressedSizes[count] = slot.compressedSize;
+            rawSizes[count] = slot.rawSize;
+            count++;
+            
+            position += slot.output.remaining();
+            writeFully(out, slot.output);
+        }
+        
+        @Override
+        void finish() throws IOException {
+            writeHeaderOnce();
+            OpenZLFrameFormat.BlockTable table = new OpenZLFrameFormat.BlockTable(blockSize, count,
+                    frameOffsets, compressedSizes, rawSizes, 0);
+            ByteBuffer footer = ByteBuffer.allocate(OpenZLFrameFormat.END_MARKER_SIZE
+                    + OpenZLFrameFormat.indexSize(count));
+            OpenZLFrameFormat.writeFooter(MemorySegment.ofArray(footer.array()), 0, position, table);
+            writeFully(out, footer);
+            written = position + footer.capacity();
+        }
+        
+        private void writeHeaderOnce() throws IOException {
+            if (position == 0) {
+                ByteBuffer header = ByteBuffer.allocate(OpenZLFrameFormat.HEADER_SIZE);
+                OpenZLFrameFormat.writeHeader(MemorySegment.ofArray(header.array()), 0,
+                        OpenZLFrameFormat.FLAG_INDEXED, blockSize);
+                writeFully(out, header);
+                position = OpenZLFrameFormat.HEADER_SIZE;
+            }
+        }
+    }
+    
+    private final class DecompressJob extends Job<OpenZLDecompressor> {
+        private final int containerBlockSize;
+        private final ByteBuffer blockHeader = ByteBuffer.allocate(OpenZLFrameFormat.BLOCK_HEADER_SIZE)
+                .order(ByteOrder.LITTLE_ENDIAN);
+        
+        DecompressJob(ReadableByteChannel in, WritableByteChannel out, int containerBlockSize) {
+            super(in, out);
+            this.containerBlockSize = containerBlockSize;
+        }
+        
+        @Override
+        OpenZLDecompressor open() {
+            return OpenZLFactory.fastDecompressor();
+        }
+        
+        @Override
+        boolean read(Slot slot) throws IOException {
+            blockHeader.clear().limit(OpenZLFrameFormat.END_MARKER_SIZE);
+            if (!readFully(in, blockHeader)) {
+                throw new EOFException("Truncated OpenZL block container: missing end marker");
+            }
+            int compressedSize = blockHeader.getInt(0);
+            if (compressedSize == 0) {
+                return false;
+            }
+            blockHeader.clear().position(OpenZLFrameFormat.END_MARKER_SIZE);
+            if (!readFully(in, blockHeader)) {
+                throw new EOFException("Truncated OpenZL block container: truncated block header");
+            }
+            int rawSize = blockHeader.getInt(4);
+            if (compressedSize < 0 || compressedSize > slot.input.capacity()
+                    || rawSize < 0 || rawSize > containerBlockSize) {
+                throw new OpenZLException("Corrupt OpenZL block container: block sizes out of bounds");
+            }
+            
+            slot.input.clear().limit(compressedSize);
+            if (!readFully(in, slot.input)) {
+                throw new EOFException("Truncated OpenZL block container: truncated block");
+            }
+            slot.compressedSize = compressedSize;
+            slot.rawSize = rawSize;
+            return true;
+        }
+        
+        @Override
+        void process(OpenZLDecompressor decompressor, Slot slot) {
+            slot.output.clear().limit(slot.rawSize);
+            int decoded = decompressor.decompress(slot.input, slot.output);
+            if (decoded != slot.rawSize) {
+                throw new OpenZLException("Block decompressed to " + decoded + " bytes, expected " + slot.rawSize);
+            }
+            slot.output.flip();
+        }
+        
+        @Override
+        void write(Slot slot) throws IOException {
+            written += slot.output.remaining();
+            writeFully(out, slot.output);
+        }
+        
+        @Override
+        void finish() {
+        }
+    }
+}
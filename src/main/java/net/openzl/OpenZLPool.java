@@ -0,0 +1,275 @@
+package net.openzl;
+
+import java.util.concurrent.atomic.AtomicIntegerArray;
+import java.util.concurrent.atomic.AtomicReferenceArray;
+import java.util.function.Function;
+
+/**
+ * Thread-safe pool of compressors and decompressors, keyed by compression graph and
+ * backend, so callers stop paying ZL_CCtx / ZL_DCtx construction on every call.
+ *
+ * Each platform thread keeps one idle instance per key in a thread-local slot, which is
+ * taken and returned without any synchronization. Further idle instances go to a shared
+ * lock-free (Treiber) stack per key, bounded by maxSharedPerKey; beyond that they are
+ * closed. Virtual threads bypass the thread-local slot and use the shared stacks only.
+ *
+ * A per-CPU pool instead keeps one set of stacks per CPU and skips the thread-local
+ * slots, so instances stay with a core rather than with a thread. Returned instances go
+ * to the stack of the CPU the caller is running on (sched_getcpu() or the Windows
+ * equivalent, read through JNI), whose caches still hold the context. Borrowing tries
+ * that stack first and then steals from the nearest CPUs, so an idle instance anywhere
+ * is reused before a new one is built.
+ *
+ * Borrowed instances must be returned with release() and never closed by the caller.
+ */
+public final class OpenZLPool implements AutoCloseable {
+    
+    private static final int BACKENDS = OpenZLBackend.values().length;
+    private static final int COMPRESSOR_SLOTS = CompressionGraph.values().length * BACKENDS;
+    private static final int SLOTS = COMPRESSOR_SLOTS + BACKENDS;
+    // Keeps the stack heads of neighbouring CPUs at least 16 references apart.
+    private static final int STRIDE = SLOTS + 16;
+    
+    private static final OpenZLPool SHARED = new OpenZLPool();
+    
+    private static final class Node {
+        final AutoCloseable value;
+        final Node next;
+        
+        Node(AutoCloseable value, Node next) {
+            this.value = value;
+            this.next = next;
+        }
+    }
+    
+    private final int maxSharedPerKey;
+    private final boolean perCpu;
+    private final int shards;
+    private final AtomicReferenceArray<Node> shared;
+    private final AtomicIntegerArray sharedCounts;
+    private final ThreadLocal<AutoCloseable[]> local = ThreadLocal.withInitial(() -> new AutoCloseable[SLOTS]);
+    private volatile boolean closed = false;
+    
+    public OpenZLPool() {
+        this(Runtime.getRuntime().availableProcessors());
+    }
+    
+    public OpenZLPool(int maxSharedPerKey) {
+        this(maxSharedPerKey, false);
+    }
+    
+    /**
+     * With perCpu set, maxSharedPerKey bounds each CPU's stack rather than the whole pool.
+     */
+    public OpenZLPool(int maxSharedPerKey, boolean perCpu) {
+        if (maxSharedPerKey < 0) {
+            throw new IllegalArgumentException("Shared pool size cannot be negative");
+        }
+        if (perCpu) {
+            OpenZLJNI.init();
+        }
+        this.maxSharedPerKey = maxSharedPerKey;
+        this.perCpu = perCpu;
+        this.shards = perCpu ? Runtime.getRuntime().availableProcessors() : 1;
+        this.shared = new AtomicReferenceArray<>(shards * STRIDE);
+        this.sharedCounts = new AtomicIntegerArray(shards * STRIDE);
+    }
+    
+    /**
+     * Process-wide pool used by OpenZLUtils.
+     */
+    public static OpenZLPool shared() {
+        return SHARED;
+    }
+    
+    public boolean isPerCpu() {
+        return perCpu;
+    }
+    
+    public OpenZLCompressor borrowCompressor(CompressionGraph graph) {
+        if (graph == null) {
+            throw new IllegalArgumentException("Compression graph cannot be null");
+        }
+        OpenZLCompressor compressor = (OpenZLCompressor) take(compressorSlot(graph, OpenZLFactory.getBackend()));
+        return compressor != null ? compressor : OpenZLFactory.compressor(graph);
+    }
+    
+    public OpenZLDecompressor borrowDecompressor() {
+        OpenZLDecompressor decompressor = (OpenZLDecompressor) take(decompressorSlot(OpenZLFactory.getBackend()));
+        return decompressor != null ? decompressor : OpenZLFactory.fastDecompressor();
+    }
+    
+    public void release(OpenZLCompressor compressor) {
+        if (compressor == null || compressor.isClosed()) {
+            return;
+        }
+        give(compressorSlot(compressor.getGraph(), compressor.getBackend()), compressor);
+    }
+    
+    public void release(OpenZLDecompressor decompressor) {
+        if (decompressor == null || decompressor.isClosed()) {
+            return;
+        }
+        give(decompressorSlot(decompressor.getBackend()), decompressor);
+    }
+    
+    public <T> T withCompressor(CompressionGraph graph, Function<OpenZLCompressor, T> action) {
+        OpenZLCompressor compressor = borrowCompressor(graph);
+        try {
+            return action.apply(compressor);
+        } finally {
+            release(compressor);
+        }
+    }
+    
+    public <T> T withDecompressor(Function<OpenZLDecompressor, T> action) {
+        OpenZLDecompressor decompressor = borrowDecompressor();
+        try {
+            return action.apply(decompressor);
+        } finally {
+            release(decompressor);
+        }
+    }
+    
+    /**
+     * Closes the instances in the shared stacks and stops pooling returned instances.
+     * Instances parked in other threads' local slots are closed when those threads next
+     * touch the pool.
+     */
+    public void close() {
+        closed = true;
+        for (int shard = 0; shard < shards; shard++) {
+            for (int slot = 0; slot < SLOTS; slot++) {
+                drainShared(shard * STRIDE + slot);
+            }
+        }
+        drainLocal();
+    }
+    
+    private AutoCloseable take(int slot) {
+        if (closed) {
+            drainLocal();
+            return null;
+        }
+        if (perCpu) {
+            return takeNearest(currentShard(), slot);
+        }
+        if (!Thread.currentThread().isVirtual()) {
+            AutoCloseable[] cache = local.get();
+            AutoCloseable cached = cache[slot];
+            if (cached != null) {
+                cache[slot] = null;
+                return cached;
+            }
+        }
+        return pop(slot);
+    }
+    
+    /**
+     * Pops from the home CPU's stack, then from CPUs home +-1, +-2, ... until one has an
+     * idle instance.
+     */
+    private AutoCloseable takeNearest(int home, int slot) {
+        AutoCloseable instance = pop(home * STRIDE + slot);
+        for (int distance = 1; instance == null && distance <= shards / 2; distance++) {
+            instance = pop(Math.floorMod(home + distance, shards) * STRIDE + slot);
+            if (instance == null && distance * 2 != shards) {
+                instance = pop(Math.floorMod(home - distance, shards) * STRIDE + slot);
+            }
+        }
+        return instance;
+    }
+    
+    private int currentShard() {
+        int cpu = OpenZLJNI.currentCpu();
+        if (cpu < 0) {
+            // No CPU number on this platform: spread threads over the shards instead.
+            cpu = Long.hashCode(Thread.currentThread().threadId());
+        }
+        return Math.floorMod(cpu, shards);
+    }
+    
+    private void give(int slot, AutoCloseable instance) {
+        if (closed) {
+            closeQuietly(instance);
+            return;
+        }
+        if (perCpu) {
+            // Back to the CPU that just used it, whose caches still hold its state.
+            slot += currentShard() * STRIDE;
+        } else if (!Thread.currentThread().isVirtual()) {
+            AutoCloseable[] cache = local.get();
+            if (cache[slot] == null) {
+                cache[slot] = instance;
+                return;
+            }
+        }
+        if (!push(slot, instance)) {
+            closeQuietly(instance);
+        } else if (closed) {
+            // Raced with close(): make sure nothing is left parked in the stack.
+            drainShared(slot);
+        }
+    }
+    
+    private AutoCloseable pop(int slot) {
+        while (true) {
+            Node head = shared.get(slot);
+            if (head == null) {
+                return null;
+            }
+            if (shared.compareAndSet(slot, head, head.next)) {
+                sharedCounts.decrementAndGet(slot);
+                return head.value;
+            }
+        }
+    }
+    
+    private boolean push(int slot, AutoCloseable instance) {
+        if (sharedCounts.incrementAndGet(slot) > maxSharedPerKey) {
+            sharedCounts.decrementAndGet(slot);
+            return false;
+        }
+        while (true) {
+            Node head = shared.get(slot);
+            if (shared.compareAndSet(slot, head, new Node(instance, head))) {
+                return true;
+            }
+        }
+    }
+    
+    private void drainShared(int slot) {
+        for (Node node = shared.getAndSet(slot, null); node != null; node = node.next) {
+            sharedCounts.decrementAndGet(slot);
+            closeQuietly(node.value);
+        }
+    }
+    
+    private void drainLocal() {
+        if (perCpu || Thread.currentThread().isVirtual()) {
+            return;
+        }
+        AutoCloseable[] cache = local.get();
+        for (int slot = 0; slot < SLOTS; slot++) {
+            if (cache[slot] != null) {
+                closeQuietly(cache[slot]);
+                cache[slot] = null;
+            }
+        }
+    }
+    
+    private static int compressorSlot(CompressionGraph graph, OpenZLBackend backend) {
+        return graph.ordinal() * BACKENDS + backend.ordinal();
+    }
+    
+    private static int decompressorSlot(OpenZLBackend backend) {
+        return COMPRESSOR_SLOTS + backend.ordinal();
+    }
+    
+    private static void closeQuietly(AutoCloseable instance) {
+        try {
+            instance.close();
+        } catch (Exception ignored) {
+        }
+    }
+}
@@ -12,9 +12,8 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Text cannot be null");
         }
         
-        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
-            return compressor.compress(text.getBytes(StandardCharsets.UTF_8));
-        }
+        byte[] bytes = text.getBytes(StandardCharsets.UTF_8);
+        return OpenZLPool.shared().withCompressor(CompressionGraph.ZSTD, compressor -> compressor.compress(bytes));
     }
     
     public static String decompressString(byte[] compressedData) {
@@ -22,10 +21,8 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Compressed data cannot be null");
         }
         
-        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
-            byte[] decompressed = decompressor.decompress(compressedData);
-            return new String(decompressed, StandardCharsets.UTF_8);
-        }
+        byte[] decompressed = OpenZLPool.shared().withDecompressor(decompressor -> decompressor.decompress(compressedData));
+        return new String(decompressed, StandardCharsets.UTF_8);
     }
     
     public static byte[] compressBinary(byte[] data) {
@@ -33,9 +30,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Data cannot be null");
         }
         
-        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
-            return compressor.compress(data);
-        }
+        return OpenZLPool.shared().withCompressor(CompressionGraph.ZSTD, compressor -> compressor.compress(data));
     }
     
     public static byte[] decompressBinary(byte[] compressedData) {
@@ -43,9 +38,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Compressed data cannot be null");
         }
         
-        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
-            return decompressor.decompress(compressedData);
-        }
+        return OpenZLPool.shared().withDecompressor(decompressor -> decompressor.decompress(compressedData));
     }
     
     public static byte[] compressInts(int[] data) {
@@ -53,9 +46,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Data cannot be null");
         }
         
-        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
-            return compressor.compressInts(data);
-        }
+        return OpenZLPool.shared().withCompressor(CompressionGraph.ZSTD, compressor -> compressor.compressInts(data));
     }
     
     public static int[] decompressInts(byte[] compressedData) {
@@ -63,9 +54,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Compressed data cannot be null");
         }
         
-        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
-            return decompressor.decompressNumericInts(compressedData);
-        }
+        return OpenZLPool.shared().withDecompressor(decompressor -> decompressor.decompressNumericInts(compressedData));
     }
     
     public static byte[] compressLongs(long[] data) {
@@ -73,9 +62,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Data cannot be null");
         }
         
-        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
-            return compressor.compressLongs(data);
-        }
+        return OpenZLPool.shared().withCompressor(CompressionGraph.ZSTD, compressor -> compressor.compressLongs(data));
     }
     
     public static long[] decompressLongs(byte[] compressedData) {
@@ -83,9 +70,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Compressed data cannot be null");
         }
         
-        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
-            return decompressor.decompressNumericLongs(compressedData);
-        }
+        return OpenZLPool.shared().withDecompressor(decompressor -> decompressor.decompressNumericLongs(compressedData));
     }
     
     public static byte[] compressFloats(float[] data) {
@@ -93,9 +78,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Data cannot be null");
         }
         
-        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
-            return compressor.compressFloats(data);
-        }
+        return OpenZLPool.shared().withCompressor(CompressionGraph.ZSTD, compressor -> compressor.compressFloats(data));
     }
     
     public static float[] decompressFloats(byte[] compressedData) {
@@ -103,9 +86,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Compressed data cannot be null");
         }
         
-        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
-            return decompressor.decompressNumericFloats(compressedData);
-        }
+        return OpenZLPool.shared().withDecompressor(decompressor -> decompressor.decompressNumericFloats(compressedData));
     }
     
     public static byte[] compressDoubles(double[] data) {
@@ -113,9 +94,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Data cannot be null");
         }
         
-        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
-            return compressor.compressDoubles(data);
-        }
+        return OpenZLPool.shared().withCompressor(CompressionGraph.ZSTD, compressor -> compressor.compressDoubles(data));
     }
     
     public static double[] decompressDoubles(byte[] compressedData) {
@@ -123,9 +102,7 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Compressed data cannot be null");
         }
         
-        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
-            return decompressor.decompressNumericDoubles(compressedData);
-        }
+        return OpenZLPool.shared().withDecompressor(decompressor -> decompressor.decompressNumericDoubles(compressedData));
     }
     
     public static CompressionInfo getCompressionInfo(byte[] compressedData) {
@@ -133,14 +110,10 @@ public final class OpenZLUtils {
             throw new IllegalArgumentException("Compressed data cannot be null");
         }
         
-        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
-            return decompressor.getInfo(compressedData);
-        }
+        return OpenZLPool.shared().withDecompressor(decompressor -> decompressor.getInfo(compressedData));
     }
     
     public static int estimateMaxCompressedSize(int originalSize) {
-        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
-            return compressor.maxCompressedLength(originalSize);
-        }
+        return OpenZLCompressor.maxCompressedLength(originalSize);
     }
 }
\ No newline at end of file
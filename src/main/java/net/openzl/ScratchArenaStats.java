@@ -0,0 +1,63 @@
+package net.openzl;
+
+/**
+ * Snapshot of the native per-thread scratch arenas, summed over all threads. In steady
+ * state overflowAllocations and systemAllocations stop growing while arenaAllocations
+ * keeps counting, i.e. transient buffers no longer reach the system allocator.
+ */
+public final class ScratchArenaStats {
+    
+    private final long liveArenas;
+    private final long retainedBytes;
+    private final long peakCallBytes;
+    private final long arenaAllocations;
+    private final long overflowAllocations;
+    private final long systemAllocations;
+    private final long systemFrees;
+    
+    ScratchArenaStats(long[] values) {
+        this.liveArenas = values[0];
+        this.retainedBytes = values[1];
+        this.peakCallBytes = values[2];
+        this.arenaAllocations = values[3];
+        this.overflowAllocations = values[4];
+        this.systemAllocations = values[5];
+        this.systemFrees = values[6];
+    }
+    
+    public long getLiveArenas() {
+        return liveArenas;
+    }
+    
+    public long getRetainedBytes() {
+        return retainedBytes;
+    }
+    
+    public long getPeakCallBytes() {
+        return peakCallBytes;
+    }
+    
+    public long getArenaAllocations() {
+        return arenaAllocations;
+    }
+    
+    public long getOverflowAllocations() {
+        return overflowAllocations;
+    }
+    
+    public long getSystemAllocations() {
+        return systemAllocations;
+    }
+    
+    public long getSystemFrees() {
+        return systemFrees;
+    }
+    
+    @Override
+    public String toString() {
+        return String.format("ScratchArenaStats{liveArenas=%d, retainedBytes=%d, peakCallBytes=%d, arenaAllocations=%d, "
+                + "overflowAllocations=%d, systemAllocations=%d, systemFrees=%d}",
+                liveArenas, retainedBytes, peakCallBytes, arenaAllocations,
+                overflowAllocations, systemAllocations, systemFrees);
+    }
+}
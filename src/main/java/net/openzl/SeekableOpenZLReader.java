@@ -0,0 +1,231 @@
+package net.openzl;
+
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Arrays;
+import java.util.Objects;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Random access into a block container (see OpenZLFrameFormat) by uncompressed offset.
+ * Opening reads only the footer index, which maps every block's uncompressed range to its
+ * frame; read() then decodes just the blocks the requested range touches. Containers
+ * written by OpenZLParallel, OpenZLPipeline, OpenZLOutputStream and OpenZLChannels all
+ * carry the index; older unindexed ones are located by walking their block headers once.
+ *
+ * Blocks a read covers completely are decoded straight into the caller's array. The most
+ * recently decoded partial block is kept, so runs of small reads inside one block
+ * decompress it once. Instances are thread-safe; contexts come from OpenZLPool.shared().
+ *
+ * close() may race reads on other threads: reads that have started finish normally, later
+ * ones throw IllegalStateException, and a mapped file is unmapped by whichever of close()
+ * and the last running read comes second, the same scheme NativeHandle uses.
+ */
+public final class SeekableOpenZLReader implements AutoCloseable {
+    
+    private static final int CLOSED = 1;
+    private static final int READER = 2;
+    
+    private final MemorySegment container;
+    private final Arena arena;
+    private final OpenZLFrameFormat.BlockTable table;
+    private final AtomicInteger state = new AtomicInteger();
+    private volatile CachedBlock cached;
+    
+    private static final class CachedBlock {
+        final int index;
+        final byte[] data;
+        
+        CachedBlock(int index, byte[] data) {
+            this.index = index;
+            this.data = data;
+        }
+    }
+    
+    public SeekableOpenZLReader(byte[] container) {
+        this(container == null ? null : MemorySegment.ofArray(container), null);
+    }
+    
+    /**
+     * Reads from a container in memory; the segment must stay alive while the reader is used.
+     */
+    public SeekableOpenZLReader(MemorySegment container) {
+        this(container, null);
+    }
+    
+    private SeekableOpenZLReader(MemorySegment container, Arena arena) {
+        if (container == null) {
+            throw new IllegalArgumentException("Container cannot be null");
+        }
+        this.container = container;
+        this.arena = arena;
+        this.table = OpenZLFrameFormat.readBlockTable(container);
+    }
+    
+    /**
+     * Memory-maps a container file. Only the pages of the index and of the blocks actually
+     * read are touched.
+     */
+    public static SeekableOpenZLReader open(Path path) throws IOException {
+        if (path == null) {
+            throw new IllegalArgumentException("Path cannot be null");
+        }
+        Arena arena = Arena.ofShared();
+        try (FileChannel channel = FileChannel.open(path, StandardOpenOption.READ)) {
+            return new SeekableOpenZLReader(channel.map(FileChannel.MapMode.READ_ONLY, 0, channel.size(), arena), arena);
+        } catch (IOException | RuntimeException e) {
+            arena.close();
+            throw e;
+        }
+    }
+    
+    /**
+     * Returns up to len bytes starting at uncompressed offset; fewer only when the range
+     * runs past the end.
+     */
+    public byte[] read(long offset, int len) {
+        if (offset < 0 || len < 0 || offset > table.rawSize) {
+            throw new IndexOutOfBoundsException("Invalid offset or length");
+        }
+        byte[] dest = new byte[(int) Math.min(len, table.rawSize - offset)];
+        read(offset, dest, 0, dest.length);
+        return dest;
+    }
+    
+    /**
+     * Copies up to len bytes starting at uncompressed offset into dest at destOff. Returns
+     * the number of bytes copied, which is less than len only at the end of the data.
+     */
+    public int read(long offset, byte[] dest, int destOff, int len) {
+        if (dest == null) {
+            throw new IllegalArgumentException("Destination array cannot be null");
+        }
+        Objects.checkFromIndexSize(destOff, len, dest.length);
+        if (offset < 0 || offset > table.rawSize) {
+            throw new IndexOutOfBoundsException("Invalid offset: " + offset);
+        }
+        acquire();
+        try {
+            int n = (int) Math.min(len, table.rawSize - offset);
+            int copied = 0;
+            int block = blockAt(offset);
+            while (copied < n) {
+                int within = (int) (offset + copied - table.rawOffsets[block]);
+                int take = Math.min(n - copied, table.rawSizes[block] - within);
+                if (within == 0 && take == table.rawSizes[block]) {
+                    decode(block, MemorySegment.ofArray(dest).asSlice(destOff + copied, take));
+                } else {
+                    System.arraycopy(decoded(block), within, dest, destOff + copied, take);
+                }
+                copied += take;
+                block++;
+            }
+            return n;
+        } finally {
+            release();
+        }
+    }
+    
+    /**
+     * Total uncompressed size of the container.
+     */
+    public long size() {
+        return table.rawSize;
+    }
+    
+    public int getBlockCount() {
+        return table.count;
+    }
+    
+    public int getBlockSize() {
+        return table.blockSize;
+    }
+    
+    /**
+     * Unmaps the file if the reader opened it, now or once reads still running on other
+     * threads return. Reads after close fail. Idempotent.
+     */
+    @Override
+    public void close() {
+        while (true) {
+            int current = state.get();
+            if ((current & CLOSED) != 0) {
+                return;
+            }
+            if (state.compareAndSet(current, current | CLOSED)) {
+                cached = null;
+                if (current == 0) {
+                    unmap();
+                }
+                return;
+            }
+        }
+    }
+    
+    /**
+     * Index of the last block starting at or before offset, skipping empty blocks.
+     */
+    private int blockAt(long offset) {
+        int block = Arrays.binarySearch(table.rawOffsets, 0, table.count, offset);
+        if (block < 0) {
+            block = -block - 2;
+        }
+        while (block + 1 < table.count && table.rawOffsets[block + 1] <= offset) {
+            block++;
+        }
+        return Math.max(block, 0);
+    }
+    
+    private byte[] decoded(int block) {
+        CachedBlock current = cached;
+        if (current != null && current.index == block) {
+            return current.data;
+        }
+        byte[] data = new byte[table.rawSizes[block]];
+        decode(block, MemorySegment.ofArray(data));
+        cached = new CachedBlock(block, data);
+        return data;
+    }
+    
+    private void decode(int block, MemorySegment dest) {
+        MemorySegment frame = container.asSlice(table.frameOffsets[block], table.compressedSizes[block]);
+        OpenZLDecompressor decompressor = OpenZLPool.shared().borrowDecompressor();
+        try {
+            long written = decompressor.decompress(frame, dest);
+            if (written != table.rawSizes[block]) {
+                throw new OpenZLException("Block " + block + " decompressed to " + written
+                        + " bytes, expected " + table.rawSizes[block]);
+            }
+        } finally {
+            OpenZLPool.shared().release(decompressor);
+        }
+    }
+    
+    private void acquire() {
+        while (true) {
+            int current = state.get();
+            if ((current & CLOSED) != 0) {
+                throw new IllegalStateException("SeekableOpenZLReader has been closed");
+            }
+            if (state.compareAndSet(current, current + READER)) {
+                return;
+            }
+        }
+    }
+    
+    private void release() {
+        if (state.addAndGet(-READER) == CLOSED) {
+            unmap();
+        }
+    }
+    
+    private void unmap() {
+        if (arena != null) {
+            arena.close();
+        }
+    }
+}
@@ -0,0 +1,90 @@
+package net.openzl.examples;
+
+import net.openzl.*;
+
+import java.util.Arrays;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Runs one large compression loop per carrier thread on virtual threads, plus a stream of
+ * short virtual-thread probes that sleep 1 ms. A probe wakes late when every carrier is
+ * pinned by a native call, so its lateness shows how much of the carrier pool the large
+ * calls hold. Each scenario runs with offloading disabled and then enabled.
+ */
+public class CarrierUtilizationBenchmark {
+
+    private static final int LARGE_SIZE = 16 * 1024 * 1024;
+    private static final int PROBES = 2_000;
+    private static final long PROBE_SLEEP_NS = TimeUnit.MILLISECONDS.toNanos(1);
+
+    public static void main(String[] args) throws Exception {
+        int carriers = Integer.getInteger("jdk.virtualThreadScheduler.parallelism",
+            Runtime.getRuntime().availableProcessors());
+        byte[] large = OpenZLExample.genData(LARGE_SIZE);
+
+        System.out.println("OpenZL virtual-thread carrier utilization benchmark");
+        System.out.printf("%d carriers, %d large compressions of %s in flight, %d probes%n",
+            carriers, carriers, OpenZLExample.fmt(LARGE_SIZE), PROBES);
+
+        int threshold = OpenZLFactory.getVirtualThreadOffloadThreshold();
+        try {
+            OpenZLFactory.setVirtualThreadOffloadThreshold(-1);
+            run("pinned   ", large, carriers);
+            OpenZLFactory.setVirtualThreadOffloadThreshold(64 * 1024);
+            run("offloaded", large, carriers);
+        } finally {
+            OpenZLFactory.setVirtualThreadOffloadThreshold(threshold);
+        }
+    }
+
+    static void run(String label, byte[] large, int carriers) throws InterruptedException {
+        AtomicBoolean running = new AtomicBoolean(true);
+        AtomicLong compressions = new AtomicLong();
+        long[] lateness = new long[PROBES];
+        CountDownLatch probesDone = new CountDownLatch(PROBES);
+
+        long t0;
+        long t1;
+        try (ExecutorService executor = Executors.newVirtualThreadPerTaskExecutor()) {
+            for (int i = 0; i < carriers; i++) {
+                executor.submit(() -> {
+                    try (var c = OpenZLFactory.fastCompressor()) {
+                        while (running.get()) {
+                            c.compress(large);
+                            compressions.incrementAndGet();
+                        }
+                    }
+                });
+            }
+
+            t0 = System.nanoTime();
+            for (int i = 0; i < PROBES; i++) {
+                int probe = i;
+                executor.submit(() -> {
+                    long start = System.nanoTime();
+                    try {
+                        Thread.sleep(1);
+                    } catch (InterruptedException e) {
+                        Thread.currentThread().interrupt();
+                    }
+                    lateness[probe] = System.nanoTime() - start - PROBE_SLEEP_NS;
+                    probesDone.countDown();
+                });
+            }
+            probesDone.await();
+            t1 = System.nanoTime();
+            running.set(false);
+        }
+
+        Arrays.sort(lateness);
+        double seconds = (t1 - t0) / 1e9;
+        System.out.printf("%s: probe lateness p50 %8.2f ms | p99 %8.2f ms | max %8.2f ms | %6.1f MB/s compressed%n",
+            label, lateness[PROBES / 2] / 1e6, lateness[PROBES * 99 / 100] / 1e6, lateness[PROBES - 1] / 1e6,
+            compressions.get() * (double) LARGE_SIZE / seconds / (1024 * 1024));
+    }
+}
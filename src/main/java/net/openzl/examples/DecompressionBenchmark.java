@@ -0,0 +1,67 @@
+package net.openzl.examples;
+
+import net.openzl.*;
+
+public class DecompressionBenchmark {
+
+    private static final int[] FRAME_SIZES = {64, 256, 1024, 4096};
+    private static final int WARMUP_ITERATIONS = 20_000;
+    private static final int ITERATIONS = 200_000;
+
+    public static void main(String[] args) {
+        System.out.println("OpenZL small-frame decompression benchmark");
+        System.out.println("Compares a fresh decompressor per call against one reused ZL_DCtx.");
+
+        for (int size : FRAME_SIZES) {
+            byte[] frame;
+            try (var c = OpenZLFactory.fastCompressor()) {
+                frame = c.compress(OpenZLExample.genData(size));
+            }
+
+            double freshNs = freshPerCall(frame);
+            double reusedNs = reusedContext(frame);
+            System.out.printf("%6s frame (%4d B compressed): fresh %8.1f ns/op | reused %8.1f ns/op | saved %5.1f%%%n",
+                OpenZLExample.fmt(size), frame.length, freshNs, reusedNs, 100.0 * (freshNs - reusedNs) / freshNs);
+        }
+    }
+
+    static double freshPerCall(byte[] frame) {
+        long sink = 0;
+        for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+            try (var d = OpenZLFactory.fastDecompressor()) {
+                sink += d.decompress(frame).length;
+            }
+        }
+        long t0 = System.nanoTime();
+        for (int i = 0; i < ITERATIONS; i++) {
+            try (var d = OpenZLFactory.fastDecompressor()) {
+                sink += d.decompress(frame).length;
+            }
+        }
+        long t1 = System.nanoTime();
+        consume(sink);
+        return (t1 - t0) / (double) ITERATIONS;
+    }
+
+    static double reusedContext(byte[] frame) {
+        long sink = 0;
+        try (var d = OpenZLFactory.fastDecompressor()) {
+            for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+                sink += d.decompress(frame).length;
+            }
+            long t0 = System.nanoTime();
+            for (int i = 0; i < ITERATIONS; i++) {
+                sink += d.decompress(frame).length;
+            }
+            long t1 = System.nanoTime();
+            consume(sink);
+            return (t1 - t0) / (double) ITERATIONS;
+        }
+    }
+
+    private static void consume(long sink) {
+        if (sink == 42) {
+            System.out.print("");
+        }
+    }
+}
@@ -0,0 +1,89 @@
+package net.openzl.examples;
+
+import net.openzl.*;
+
+import java.io.IOException;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+
+/**
+ * Compresses one file three ways and reports input MB/s for each: the OpenZLPipeline over
+ * FileChannels (plain read / write syscalls per block), OpenZLFiles on the mapped path
+ * (mmap + pwrite), and OpenZLFiles with io_uring when isIoUringAvailable(). One worker by
+ * default, so the runs show how well a single core's compression is kept fed.
+ *
+ * -Dsize=<MB> sets the file size (default 1024), -Dthreads=<n> the workers (default 1),
+ * -Druns=<n> the timed runs per mode (default 3), -Ddir=<path> where the files go (default
+ * the temp directory). The input is written just before the runs, so it is usually in the
+ * page cache; drop caches between runs to measure cold storage.
+ */
+public class FileCompressionBenchmark {
+
+    private static final int CHUNK = 4 * 1024 * 1024;
+
+    public static void main(String[] args) throws IOException {
+        long size = Long.getLong("size", 1024) * 1024 * 1024;
+        int threads = Integer.getInteger("threads", 1);
+        int runs = Integer.getInteger("runs", 3);
+        Path dir = Path.of(System.getProperty("dir", System.getProperty("java.io.tmpdir")));
+
+        Path src = Files.createTempFile(dir, "openzl-bench", ".raw");
+        Path dest = Files.createTempFile(dir, "openzl-bench", ".ozl");
+        try {
+            writeInput(src, size);
+            System.out.println("OpenZL file compression benchmark");
+            System.out.printf("%s input, %d worker(s), %d runs, io_uring %s%n",
+                fmt(size), threads, runs, OpenZLFiles.isIoUringAvailable() ? "available" : "unavailable");
+
+            OpenZLFiles.Options options = OpenZLFiles.Options.defaults().withThreads(threads);
+            OpenZLPipeline pipeline = new OpenZLPipeline(CompressionGraph.ZSTD, options.getBlockSize(), threads);
+
+            report("read/write pipeline", size, runs, () -> {
+                try (FileChannel in = FileChannel.open(src, StandardOpenOption.READ);
+                     FileChannel out = FileChannel.open(dest, StandardOpenOption.WRITE,
+                         StandardOpenOption.TRUNCATE_EXISTING)) {
+                    return pipeline.compress(in, out);
+                }
+            });
+            report("mmap + pwrite", size, runs, () -> OpenZLFiles.compress(src, dest, options));
+            if (OpenZLFiles.isIoUringAvailable()) {
+                report("io_uring", size, runs, () -> OpenZLFiles.compress(src, dest, options.withIoUring(true)));
+            }
+        } finally {
+            Files.deleteIfExists(src);
+            Files.deleteIfExists(dest);
+        }
+    }
+
+    interface Job {
+        long run() throws IOException;
+    }
+
+    static void report(String name, long size, int runs, Job job) throws IOException {
+        long compressed = job.run();
+        double best = 0;
+        for (int i = 0; i < runs; i++) {
+            long t0 = System.nanoTime();
+            job.run();
+            double mbps = size / 1048576.0 / ((System.nanoTime() - t0) / 1e9);
+            best = Math.max(best, mbps);
+        }
+        System.out.printf("%-20s %8.1f MB/s best | ratio %.2fx%n", name, best, (double) size / compressed);
+    }
+
+    static void writeInput(Path path, long size) throws IOException {
+        byte[] chunk = OpenZLExample.genData(CHUNK);
+        try (var out = Files.newOutputStream(path)) {
+            for (long written = 0; written < size; written += CHUNK) {
+                out.write(chunk, 0, (int) Math.min(CHUNK, size - written));
+            }
+        }
+    }
+
+    static String fmt(long bytes) {
+        return bytes >= 1L << 30 ? String.format("%.1f GB", bytes / (double) (1L << 30))
+            : OpenZLExample.fmt((int) bytes);
+    }
+}
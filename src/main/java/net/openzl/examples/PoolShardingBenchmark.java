@@ -0,0 +1,79 @@
+package net.openzl.examples;
+
+import net.openzl.*;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.LongAdder;
+
+/**
+ * Measures borrow / compress / release throughput of the default pool (thread-local slot
+ * plus one shared stack per key) against a per-CPU pool, at 8, 32 and 64 threads. Small
+ * frames keep the pool operations and context cache misses a visible share of each call.
+ * Thread counts can be overridden with -Dthreads=8,32,64.
+ */
+public class PoolShardingBenchmark {
+
+    private static final int FRAME_SIZE = 4 * 1024;
+    private static final long WARMUP_MS = 1_000;
+    private static final long MEASURE_MS = 3_000;
+
+    public static void main(String[] args) throws InterruptedException {
+        String[] counts = System.getProperty("threads", "8,32,64").split(",");
+        byte[] data = OpenZLExample.genData(FRAME_SIZE);
+
+        System.out.println("OpenZL per-CPU pool benchmark");
+        System.out.printf("%d CPUs, %s frames, %d ms per run%n",
+            Runtime.getRuntime().availableProcessors(), OpenZLExample.fmt(FRAME_SIZE), MEASURE_MS);
+
+        for (String count : counts) {
+            int threads = Integer.parseInt(count.trim());
+            double global;
+            double perCpu;
+            try (var pool = new OpenZLPool()) {
+                global = run(pool, data, threads);
+            }
+            try (var pool = new OpenZLPool(2, true)) {
+                perCpu = run(pool, data, threads);
+            }
+            System.out.printf("%3d threads: global %10.0f ops/s | per-CPU %10.0f ops/s | %+6.1f%%%n",
+                threads, global, perCpu, 100.0 * (perCpu - global) / global);
+        }
+    }
+
+    static double run(OpenZLPool pool, byte[] data, int threads) throws InterruptedException {
+        AtomicBoolean measuring = new AtomicBoolean(false);
+        AtomicBoolean running = new AtomicBoolean(true);
+        LongAdder ops = new LongAdder();
+        CountDownLatch done = new CountDownLatch(threads);
+
+        for (int i = 0; i < threads; i++) {
+            Thread thread = new Thread(() -> {
+                try {
+                    while (running.get()) {
+                        pool.withCompressor(CompressionGraph.ZSTD, c -> c.compress(data));
+                        if (measuring.get()) {
+                            ops.increment();
+                        }
+                    }
+                } finally {
+                    done.countDown();
+                }
+            }, "pool-bench-" + i);
+            thread.setDaemon(true);
+            thread.start();
+        }
+
+        Thread.sleep(WARMUP_MS);
+        measuring.set(true);
+        long t0 = System.nanoTime();
+        Thread.sleep(MEASURE_MS);
+        measuring.set(false);
+        long t1 = System.nanoTime();
+        running.set(false);
+        done.await(10, TimeUnit.SECONDS);
+
+        return ops.sum() / ((t1 - t0) / 1e9);
+    }
+}
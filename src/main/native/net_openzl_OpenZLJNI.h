@@ -23,6 +23,30 @@ JNIEXPORT void JNICALL Java_net_openzl_OpenZLJNI_nativeInit
 JNIEXPORT void JNICALL Java_net_openzl_OpenZLJNI_nativeShutdown
   (JNIEnv *, jclass);
 
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    setCriticalArrayThreshold
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_net_openzl_OpenZLJNI_setCriticalArrayThreshold
+  (JNIEnv *, jclass, jint);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    setScratchArenaRetainLimit
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_net_openzl_OpenZLJNI_setScratchArenaRetainLimit
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    getScratchArenaStats
+ * Signature: ()[J
+ */
+JNIEXPORT jlongArray JNICALL Java_net_openzl_OpenZLJNI_getScratchArenaStats
+  (JNIEnv *, jclass);
+
 /*
  * Class:     net_openzl_OpenZLJNI
  * Method:    createCompressor
@@ -71,6 +95,14 @@ JNIEXPORT jbyteArray JNICALL Java_net_openzl_OpenZLJNI_compressSerial
 JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_compressSerialToBuffer
   (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jbyteArray, jint, jint);
 
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    compressDirect
+ * Signature: (JLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_compressDirect
+  (JNIEnv *, jclass, jlong, jobject, jint, jint, jobject, jint, jint);
+
 /*
  * Class:     net_openzl_OpenZLJNI
  * Method:    compressNumeric
@@ -127,6 +159,14 @@ JNIEXPORT jbyteArray JNICALL Java_net_openzl_OpenZLJNI_decompressSerial
 JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_decompressSerialToBuffer
   (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jbyteArray, jint, jint);
 
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressDirect
+ * Signature: (JLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_decompressDirect
+  (JNIEnv *, jclass, jlong, jobject, jint, jint, jobject, jint, jint);
+
 /*
  * Class:     net_openzl_OpenZLJNI
  * Method:    decompressNumeric
@@ -167,6 +207,38 @@ JNIEXPORT jfloatArray JNICALL Java_net_openzl_OpenZLJNI_decompressNumericFloats
 JNIEXPORT jdoubleArray JNICALL Java_net_openzl_OpenZLJNI_decompressNumericDoubles
   (JNIEnv *, jclass, jlong, jbyteArray);
 
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressNumericIntsInto
+ * Signature: (J[BII[II)I
+ */
+JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_decompressNumericIntsInto
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jintArray, jint);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressNumericLongsInto
+ * Signature: (J[BII[JI)I
+ */
+JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_decompressNumericLongsInto
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jlongArray, jint);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressNumericFloatsInto
+ * Signature: (J[BII[FI)I
+ */
+JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_decompressNumericFloatsInto
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jfloatArray, jint);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressNumericDoublesInto
+ * Signature: (J[BII[DI)I
+ */
+JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_decompressNumericDoublesInto
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jdoubleArray, jint);
+
 /*
  * Class:     net_openzl_OpenZLJNI
  * Method:    getCompressionInfo
@@ -178,10 +250,90 @@ JNIEXPORT jobject JNICALL Java_net_openzl_OpenZLJNI_getCompressionInfo
 /*
  * Class:     net_openzl_OpenZLJNI
  * Method:    compressBound
- * Signature: (I)I
+ * Signature: (J)J
  */
-JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_compressBound
-  (JNIEnv *, jclass, jint);
+JNIEXPORT jlong JNICALL Java_net_openzl_OpenZLJNI_compressBound
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    currentCpu
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_net_openzl_OpenZLJNI_currentCpu
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    compressBatch
+ * Signature: (J[Ljava/lang/Object;[I[I[I)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_net_openzl_OpenZLJNI_compressBatch
+  (JNIEnv *, jclass, jlong, jobjectArray, jintArray, jintArray, jintArray);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressBatch
+ * Signature: (J[B[I)[[B
+ */
+JNIEXPORT jobjectArray JNICALL Java_net_openzl_OpenZLJNI_decompressBatch
+  (JNIEnv *, jclass, jlong, jbyteArray, jintArray);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    compressParallel
+ * Signature: (IJJJJII)J
+ */
+JNIEXPORT jlong JNICALL Java_net_openzl_OpenZLJNI_compressParallel
+  (JNIEnv *, jclass, jint, jlong, jlong, jlong, jlong, jint, jint);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressParallel
+ * Signature: (JJJJ[J[I[J[II)J
+ */
+JNIEXPORT jlong JNICALL Java_net_openzl_OpenZLJNI_decompressParallel
+  (JNIEnv *, jclass, jlong, jlong, jlong, jlong, jlongArray, jintArray, jlongArray, jintArray, jint);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    scanFrames
+ * Signature: (JJ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_net_openzl_OpenZLJNI_scanFrames
+  (JNIEnv *, jclass, jlong, jlong);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    scanFramesArray
+ * Signature: ([BII)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_net_openzl_OpenZLJNI_scanFramesArray
+  (JNIEnv *, jclass, jbyteArray, jint, jint);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    compressFile
+ * Signature: ([B[BIIIZZ)J
+ */
+JNIEXPORT jlong JNICALL Java_net_openzl_OpenZLJNI_compressFile
+  (JNIEnv *, jclass, jbyteArray, jbyteArray, jint, jint, jint, jboolean, jboolean);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    decompressFile
+ * Signature: ([B[BIZ)J
+ */
+JNIEXPORT jlong JNICALL Java_net_openzl_OpenZLJNI_decompressFile
+  (JNIEnv *, jclass, jbyteArray, jbyteArray, jint, jboolean);
+
+/*
+ * Class:     net_openzl_OpenZLJNI
+ * Method:    ioUringAvailable
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_net_openzl_OpenZLJNI_ioUringAvailable
+  (JNIEnv *, jclass);
 
 
 #ifdef __cplusplus
@@ -10,25 +10,79 @@
 //
 // This file only provides JNI bindings for OpenZL and is not affiliated with Meta.
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
 #include <jni.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(OPENZL_JNI_HAVE_IO_URING)
+#include <liburing.h>
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
 #include "openzl.h"
+#include "openzl_jni_pool.h"
 
-static void throw_exception(JNIEnv *env, const char *exception_class, const char *message) {
-    jclass exc_class = (*env)->FindClass(env, exception_class);
+enum {
+    DATA_TYPE_SERIAL,
+    DATA_TYPE_STRUCT,
+    DATA_TYPE_NUMERIC,
+    DATA_TYPE_STRING,
+    DATA_TYPE_UNKNOWN,
+    DATA_TYPE_COUNT
+};
+
+static const char *const data_type_names[DATA_TYPE_COUNT] = {
+    "SERIAL", "STRUCT", "NUMERIC", "STRING", "UNKNOWN"
+};
+
+/**
+ * Classes, method IDs and constant objects resolved once in JNI_OnLoad and pinned with
+ * global references, so no entry point ever needs FindClass or Get*MethodID.
+ */
+static struct {
+    jclass openzl_exception;
+    jclass out_of_memory_error;
+    jclass illegal_argument_exception;
+    jclass index_out_of_bounds_exception;
+    jclass unsupported_operation_exception;
+    jclass io_exception;
+    jclass compression_info;
+    jclass byte_array;
+    jmethodID compression_info_init;
+    jobject graph_zstd;
+    jobject graph_numeric;
+    jstring data_types[DATA_TYPE_COUNT];
+} jni_cache;
+
+static void throw_exception(JNIEnv *env, jclass exc_class, const char *message) {
     if (exc_class != NULL) {
         (*env)->ThrowNew(env, exc_class, message);
     }
 }
 
 static void throw_openzl_exception(JNIEnv *env, const char *message) {
-    throw_exception(env, "net/openzl/OpenZLException", message);
+    throw_exception(env, jni_cache.openzl_exception, message);
 }
 
 static void throw_out_of_memory(JNIEnv *env) {
-    throw_exception(env, "java/lang/OutOfMemoryError", "Failed to allocate memory");
+    throw_exception(env, jni_cache.out_of_memory_error, "Failed to allocate memory");
 }
 
 static void throw_openzl_report_error(JNIEnv *env, ZL_Report report) {
@@ -39,28 +93,6 @@ static void throw_openzl_report_error(JNIEnv *env, ZL_Report report) {
     }
 }
 
-/**
- * Helper function to safely release JNI array elements and free allocated memory.
- * This reduces code duplication in error handling paths.
- */
-static void cleanup_int_array_and_buffer(JNIEnv *env, jintArray array, jint *array_elements, void *buffer) {
-    if (array_elements != NULL && array != NULL) {
-        (*env)->ReleaseIntArrayElements(env, array, array_elements, JNI_ABORT);
-    }
-    if (buffer != NULL) {
-        free(buffer);
-    }
-}
-
-static void cleanup_byte_array_and_buffer(JNIEnv *env, jbyteArray array, jbyte *array_elements, void *buffer) {
-    if (array_elements != NULL && array != NULL) {
-        (*env)->ReleaseByteArrayElements(env, array, array_elements, JNI_ABORT);
-    }
-    if (buffer != NULL) {
-        free(buffer);
-    }
-}
-
 /**
  * Helper function to safely free OpenZL typed reference.
  */
@@ -70,1134 +102,3606 @@ static void cleanup_typed_ref(ZL_TypedRef *typed_ref) {
     }
 }
 
-typedef struct {
-    ZL_CCtx *ctx;
-    ZL_Compressor *compressor;
-    ZL_GraphID graph_id;
-} openzl_compressor_t;
+/**
+ * Per-thread scratch arena that every transient native buffer is drawn from: bound-sized
+ * compression output, decompression staging and windows copied out of large Java arrays.
+ *
+ * Each thread owns one contiguous block that allocations bump through. A request that does
+ * not fit is served by a one-off system allocation, and when the outermost scope ends the
+ * block is regrown to the scope's total demand, so repeated traffic of a similar shape is
+ * served from the block without touching malloc. Blocks are never grown past the retain
+ * limit, and a block that exceeds it is released at the end of the scope.
+ */
+#define SCRATCH_ALIGNMENT ((size_t)16)
+#define DEFAULT_SCRATCH_RETAIN_LIMIT ((jlong)64 * 1024 * 1024)
+
+enum {
+    SCRATCH_STAT_RETAINED_BYTES,
+    SCRATCH_STAT_PEAK_SCOPE_BYTES,
+    SCRATCH_STAT_ARENA_ALLOCS,
+    SCRATCH_STAT_OVERFLOW_ALLOCS,
+    SCRATCH_STAT_SYSTEM_ALLOCS,
+    SCRATCH_STAT_SYSTEM_FREES,
+    SCRATCH_STAT_COUNT
+};
 
+typedef union scratch_overflow {
+    union scratch_overflow *next;
+    max_align_t align;
+} scratch_overflow_t;
+
+typedef struct scratch_arena {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    size_t overflow_bytes;
+    size_t demand;
+    int depth;
+    scratch_overflow_t *overflow;
+    struct scratch_arena *prev;
+    struct scratch_arena *next;
+    // Written only by the owning thread, read by scratch_arena_stats().
+    atomic_llong stats[SCRATCH_STAT_COUNT];
+} scratch_arena_t;
+
+/**
+ * Saved arena position; everything allocated after scratch_begin() is released by the
+ * matching scratch_end(). Scopes nest.
+ */
 typedef struct {
-    ZL_DCtx *ctx;
-} openzl_decompressor_t;
+    scratch_arena_t *arena;
+    size_t used;
+    size_t overflow_bytes;
+    scratch_overflow_t *overflow;
+} scratch_scope_t;
 
-JNIEXPORT void JNICALL
-Java_net_openzl_OpenZLJNI_nativeInit(JNIEnv *env, jclass clazz) {
-    // Currently OpenZL doesn't require explicit initialization
+static volatile jlong scratch_retain_limit = DEFAULT_SCRATCH_RETAIN_LIMIT;
+
+// Registry of live arenas plus the folded totals of exited threads, for stats only.
+static scratch_arena_t *scratch_arenas;
+static long long scratch_retired_stats[SCRATCH_STAT_COUNT];
+
+#if defined(_WIN32)
+static SRWLOCK scratch_registry_lock = SRWLOCK_INIT;
+static DWORD scratch_arena_key = FLS_OUT_OF_INDEXES;
+
+static void scratch_registry_acquire(void) { AcquireSRWLockExclusive(&scratch_registry_lock); }
+static void scratch_registry_release(void) { ReleaseSRWLockExclusive(&scratch_registry_lock); }
+#else
+static pthread_mutex_t scratch_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t scratch_arena_key;
+static int scratch_arena_key_created;
+
+static void scratch_registry_acquire(void) { pthread_mutex_lock(&scratch_registry_lock); }
+static void scratch_registry_release(void) { pthread_mutex_unlock(&scratch_registry_lock); }
+#endif
+
+static void scratch_stat_add(scratch_arena_t *arena, int stat, long long delta) {
+    long long value = atomic_load_explicit(&arena->stats[stat], memory_order_relaxed);
+    atomic_store_explicit(&arena->stats[stat], value + delta, memory_order_relaxed);
+}
+
+static void scratch_release_block(scratch_arena_t *arena) {
+    if (arena->base != NULL) {
+        free(arena->base);
+        scratch_stat_add(arena, SCRATCH_STAT_SYSTEM_FREES, 1);
+        scratch_stat_add(arena, SCRATCH_STAT_RETAINED_BYTES, -(long long)arena->capacity);
+    }
+    arena->base = NULL;
+    arena->capacity = 0;
+}
+
+static void scratch_arena_destroy(void *ptr) {
+    scratch_arena_t *arena = ptr;
+    if (arena == NULL) return;
+    
+    while (arena->overflow != NULL) {
+        scratch_overflow_t *block = arena->overflow;
+        arena->overflow = block->next;
+        free(block);
+        scratch_stat_add(arena, SCRATCH_STAT_SYSTEM_FREES, 1);
+    }
+    scratch_release_block(arena);
+    
+    scratch_registry_acquire();
+    for (int i = 0; i < SCRATCH_STAT_COUNT; i++) {
+        long long value = atomic_load_explicit(&arena->stats[i], memory_order_relaxed);
+        if (i == SCRATCH_STAT_PEAK_SCOPE_BYTES) {
+            if (value > scratch_retired_stats[i]) scratch_retired_stats[i] = value;
+        } else {
+            scratch_retired_stats[i] += value;
+        }
+    }
+    if (arena->prev != NULL) arena->prev->next = arena->next;
+    else scratch_arenas = arena->next;
+    if (arena->next != NULL) arena->next->prev = arena->prev;
+    scratch_registry_release();
+    
+    free(arena);
+}
+
+#if defined(_WIN32)
+static void WINAPI scratch_arena_thread_exit(PVOID arena) {
+    scratch_arena_destroy(arena);
+}
+#endif
+
+static int scratch_arena_key_init(void) {
+#if defined(_WIN32)
+    scratch_arena_key = FlsAlloc(scratch_arena_thread_exit);
+    return scratch_arena_key == FLS_OUT_OF_INDEXES ? -1 : 0;
+#else
+    if (pthread_key_create(&scratch_arena_key, scratch_arena_destroy) != 0) {
+        return -1;
+    }
+    scratch_arena_key_created = 1;
+    return 0;
+#endif
 }
 
 /**
- * Shuts down the OpenZL native library and performs cleanup operations.
- * 
- * This method provides symmetry with nativeInit() and allows for future cleanup
- * operations if OpenZL introduces global state that needs to be released.
- * Currently, OpenZL doesn't require explicit shutdown, but this method is
- * provided for future-proofing and API completeness.
+ * Deletes the TLS slot. Arenas of threads that are still alive at unload are not reclaimed.
  */
- 
-JNIEXPORT void JNICALL
-Java_net_openzl_OpenZLJNI_nativeShutdown(JNIEnv *env, jclass clazz) {
-    // Currently OpenZL doesn't require explicit shutdown
+static void scratch_arena_key_delete(void) {
+#if defined(_WIN32)
+    if (scratch_arena_key != FLS_OUT_OF_INDEXES) {
+        FlsFree(scratch_arena_key);
+        scratch_arena_key = FLS_OUT_OF_INDEXES;
+    }
+#else
+    if (scratch_arena_key_created) {
+        pthread_key_delete(scratch_arena_key);
+        scratch_arena_key_created = 0;
+    }
+#endif
 }
 
 /**
- * Creates a new OpenZL compressor configured with the specified built-in compression graph.
- * 
- * Graph ID mappings:
- *   0, default: ZSTD (fallback)
- *   1, 9       : Generic compressor (ZL_GRAPH_COMPRESS_GENERIC)
- *   2          : FieldLZ (numeric/structured data)
- *   3          : Store (no compression)
- *   4          : FSE entropy coding
- *   5          : Huffman coding
- *   6          : General entropy coding
- *   7          : Bitpacking
- *   8          : Constant-value optimization
- *
- * Returns a native pointer to the compressor; caller must call destroyCompressor() to free it.
+ * Returns the calling thread's arena, creating it on first use, or NULL when out of memory.
  */
+static scratch_arena_t *scratch_arena_get(void) {
+#if defined(_WIN32)
+    if (scratch_arena_key == FLS_OUT_OF_INDEXES) return NULL;
+    scratch_arena_t *arena = FlsGetValue(scratch_arena_key);
+#else
+    if (!scratch_arena_key_created) return NULL;
+    scratch_arena_t *arena = pthread_getspecific(scratch_arena_key);
+#endif
+    if (arena != NULL) {
+        return arena;
+    }
+    
+    arena = calloc(1, sizeof(scratch_arena_t));
+    if (arena == NULL) {
+        return NULL;
+    }
+#if defined(_WIN32)
+    int stored = FlsSetValue(scratch_arena_key, arena);
+#else
+    int stored = pthread_setspecific(scratch_arena_key, arena) == 0;
+#endif
+    if (!stored) {
+        free(arena);
+        return NULL;
+    }
+    
+    scratch_registry_acquire();
+    arena->next = scratch_arenas;
+    if (scratch_arenas != NULL) scratch_arenas->prev = arena;
+    scratch_arenas = arena;
+    scratch_registry_release();
+    return arena;
+}
 
-JNIEXPORT jlong JNICALL
-Java_net_openzl_OpenZLJNI_createCompressor(JNIEnv *env, jclass clazz, jint graph_id) {
-    openzl_compressor_t *compressor = malloc(sizeof(openzl_compressor_t));
-    if (compressor == NULL) {
-        throw_out_of_memory(env);
-        return 0;
+static scratch_scope_t scratch_begin(void) {
+    scratch_scope_t scope = { scratch_arena_get(), 0, 0, NULL };
+    if (scope.arena != NULL) {
+        scope.used = scope.arena->used;
+        scope.overflow_bytes = scope.arena->overflow_bytes;
+        scope.overflow = scope.arena->overflow;
+        scope.arena->depth++;
+    }
+    return scope;
+}
+
+/**
+ * Returns size bytes of 16-byte aligned scratch memory valid until the scope ends,
+ * or NULL when out of memory. The caller is responsible for throwing.
+ */
+static void *scratch_alloc(scratch_scope_t *scope, size_t size) {
+    scratch_arena_t *arena = scope->arena;
+    if (arena == NULL) {
+        return NULL;
     }
     
-    compressor->ctx = ZL_CCtx_create();
-    if (compressor->ctx == NULL) {
-        free(compressor);
-        throw_openzl_exception(env, "Failed to create compression context");
-        return 0;
+    size_t aligned = (size + SCRATCH_ALIGNMENT - 1) & ~(SCRATCH_ALIGNMENT - 1);
+    if (aligned < size) {
+        return NULL;
     }
-    
-    compressor->compressor = ZL_Compressor_create();
-    if (compressor->compressor == NULL) {
-        ZL_CCtx_free(compressor->ctx);
-        free(compressor);
-        throw_openzl_exception(env, "Failed to create compressor object");
-        return 0;
+    if (aligned == 0) {
+        aligned = SCRATCH_ALIGNMENT;
     }
     
-    ZL_GraphID selected_graph;
-    switch (graph_id) {
-        case 0:
-            selected_graph = ZL_GRAPH_ZSTD;
-            break;
-        case 1:
-            selected_graph = ZL_GRAPH_COMPRESS_GENERIC;
-            break;
-        case 2:
-            selected_graph = ZL_GRAPH_FIELD_LZ;
-            break;
-        case 3:
-            selected_graph = ZL_GRAPH_STORE;
-            break;  
-        case 4:
-            selected_graph = ZL_GRAPH_FSE;
-            break;
-        case 5:
-            selected_graph = ZL_GRAPH_HUFFMAN;
-            break;
-        case 6:
-            selected_graph = ZL_GRAPH_ENTROPY;
-            break;
-        case 7:
-            selected_graph = ZL_GRAPH_BITPACK;
-            break;
-        case 8:
-            selected_graph = ZL_GRAPH_CONSTANT;
-            break;
-        case 9:
-            selected_graph = ZL_GRAPH_COMPRESS_GENERIC;
-            break;
-        default:
-            selected_graph = ZL_GRAPH_ZSTD;
-            break;
+    void *ptr;
+    if (arena->capacity - arena->used >= aligned) {
+        ptr = arena->base + arena->used;
+        arena->used += aligned;
+        scratch_stat_add(arena, SCRATCH_STAT_ARENA_ALLOCS, 1);
+    } else {
+        if (aligned > SIZE_MAX - sizeof(scratch_overflow_t)) {
+            return NULL;
+        }
+        scratch_overflow_t *block = malloc(sizeof(scratch_overflow_t) + aligned);
+        if (block == NULL) {
+            return NULL;
+        }
+        block->next = arena->overflow;
+        arena->overflow = block;
+        arena->overflow_bytes += aligned;
+        scratch_stat_add(arena, SCRATCH_STAT_OVERFLOW_ALLOCS, 1);
+        scratch_stat_add(arena, SCRATCH_STAT_SYSTEM_ALLOCS, 1);
+        ptr = block + 1;
     }
     
-    compressor->graph_id = selected_graph;
-    
-    ZL_Report result = ZL_CCtx_setParameter(compressor->ctx, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION);
-    if (ZL_isError(result)) {
-        ZL_Compressor_free(compressor->compressor);
-        ZL_CCtx_free(compressor->ctx);
-        free(compressor);
-        throw_openzl_report_error(env, result);
-        return 0;
+    size_t demand = arena->used + arena->overflow_bytes;
+    if (demand > arena->demand) {
+        arena->demand = demand;
     }
-    
-    result = ZL_CCtx_setParameter(compressor->ctx, ZL_CParam_compressionLevel, ZL_COMPRESSIONLEVEL_DEFAULT);
-    if (ZL_isError(result)) {
-        ZL_Compressor_free(compressor->compressor);
-        ZL_CCtx_free(compressor->ctx);
-        free(compressor);
-        throw_openzl_report_error(env, result);
-        return 0;
+    return ptr;
+}
+
+/**
+ * Grows or trims the block once the outermost scope has released everything: it is
+ * regrown to cover the demand just seen when that fits under the retain limit, and
+ * dropped when it has come to exceed the limit (e.g. after the limit was lowered).
+ */
+static void scratch_settle(scratch_arena_t *arena) {
+    size_t limit = scratch_retain_limit > 0 ? (size_t)scratch_retain_limit : 0;
+    size_t demand = arena->demand;
+    arena->demand = 0;
+    
+    long long peak = atomic_load_explicit(&arena->stats[SCRATCH_STAT_PEAK_SCOPE_BYTES], memory_order_relaxed);
+    if ((long long)demand > peak) {
+        atomic_store_explicit(&arena->stats[SCRATCH_STAT_PEAK_SCOPE_BYTES], (long long)demand, memory_order_relaxed);
+    }
+    
+    if (demand > arena->capacity && demand <= limit) {
+        size_t capacity = arena->capacity * 2;
+        if (capacity < demand) capacity = demand;
+        if (capacity > limit) capacity = limit;
+    
+        scratch_release_block(arena);
+        arena->base = malloc(capacity);
+        if (arena->base != NULL) {
+            arena->capacity = capacity;
+            scratch_stat_add(arena, SCRATCH_STAT_SYSTEM_ALLOCS, 1);
+            scratch_stat_add(arena, SCRATCH_STAT_RETAINED_BYTES, (long long)capacity);
+        }
+    } else if (arena->capacity > limit) {
+        scratch_release_block(arena);
     }
+}
+
+static void scratch_end(scratch_scope_t *scope) {
+    scratch_arena_t *arena = scope->arena;
+    if (arena == NULL) return;
     
-    result = ZL_Compressor_selectStartingGraphID(compressor->compressor, selected_graph);
-    if (ZL_isError(result)) {
-        ZL_Compressor_free(compressor->compressor);
-        ZL_CCtx_free(compressor->ctx);
-        free(compressor);
-        throw_openzl_report_error(env, result);
-        return 0;
+    while (arena->overflow != scope->overflow) {
+        scratch_overflow_t *block = arena->overflow;
+        arena->overflow = block->next;
+        free(block);
+        scratch_stat_add(arena, SCRATCH_STAT_SYSTEM_FREES, 1);
     }
+    arena->used = scope->used;
+    arena->overflow_bytes = scope->overflow_bytes;
     
-    result = ZL_CCtx_refCompressor(compressor->ctx, compressor->compressor);
-    if (ZL_isError(result)) {
-        ZL_Compressor_free(compressor->compressor);
-        ZL_CCtx_free(compressor->ctx);
-        free(compressor);
-        throw_openzl_report_error(env, result);
-        return 0;
+    if (--arena->depth == 0) {
+        scratch_settle(arena);
     }
-    
-    return (jlong)(uintptr_t)compressor;
 }
 
 /**
- * Frees a compressor instance created by createCompressor().
+ * Sums the counters of all live arenas and of the arenas of threads that have exited.
+ * The first element is the number of live arenas, followed by the SCRATCH_STAT_* values.
  */
-JNIEXPORT void JNICALL
-Java_net_openzl_OpenZLJNI_destroyCompressor(JNIEnv *env, jclass clazz, jlong compressor_ptr) {
-    if (compressor_ptr == 0) return;
-    
-    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
-    if (compressor->compressor != NULL) {
-        ZL_Compressor_free(compressor->compressor);
+static void scratch_arena_stats(long long out[SCRATCH_STAT_COUNT + 1]) {
+    scratch_registry_acquire();
+    out[0] = 0;
+    for (int i = 0; i < SCRATCH_STAT_COUNT; i++) {
+        out[i + 1] = scratch_retired_stats[i];
+    }
+    for (scratch_arena_t *arena = scratch_arenas; arena != NULL; arena = arena->next) {
+        out[0]++;
+        for (int i = 0; i < SCRATCH_STAT_COUNT; i++) {
+            long long value = atomic_load_explicit(&arena->stats[i], memory_order_relaxed);
+            if (i == SCRATCH_STAT_PEAK_SCOPE_BYTES) {
+                if (value > out[i + 1]) out[i + 1] = value;
+            } else {
+                out[i + 1] += value;
+            }
+        }
+    }
+    scratch_registry_release();
+}
+
+/**
+ * Combined source + destination size, in bytes, up to which Java arrays are pinned with
+ * GetPrimitiveArrayCritical. Critical access avoids any copy but holds off GC for the
+ * duration of the call, so larger payloads copy just the window they need through the
+ * thread's scratch arena instead.
+ */
+#define DEFAULT_CRITICAL_ARRAY_THRESHOLD (256 * 1024)
+
+static volatile jint critical_array_threshold = DEFAULT_CRITICAL_ARRAY_THRESHOLD;
+
+static int use_critical_access(size_t src_size, size_t dest_size) {
+    return src_size + dest_size <= (size_t)critical_array_threshold;
+}
+
+typedef enum {
+    ARRAY_BYTE,
+    ARRAY_INT,
+    ARRAY_LONG,
+    ARRAY_FLOAT,
+    ARRAY_DOUBLE
+} array_kind_t;
+
+static size_t array_kind_width(array_kind_t kind) {
+    switch (kind) {
+        case ARRAY_INT:
+            return sizeof(jint);
+        case ARRAY_LONG:
+            return sizeof(jlong);
+        case ARRAY_FLOAT:
+            return sizeof(jfloat);
+        case ARRAY_DOUBLE:
+            return sizeof(jdouble);
+        case ARRAY_BYTE:
+        default:
+            return 1;
     }
-    if (compressor->ctx != NULL) {
-        ZL_CCtx_free(compressor->ctx);
+}
+
+/**
+ * A window of [offset, offset + length) elements of a Java primitive array made visible
+ * to native code, either pinned critically or copied into the thread's scratch arena.
+ */
+typedef struct {
+    jarray array;
+    array_kind_t kind;
+    jsize offset;
+    jsize length;
+    void *pinned;
+    void *data;
+} array_region_t;
+
+/**
+ * Throws IndexOutOfBoundsException unless the window lies inside the array. Critical
+ * access reads the pinned array without any JNI bounds check, so this must run before
+ * anything is pinned. Returns 1 if the window is valid.
+ */
+static int region_in_bounds(JNIEnv *env, const array_region_t *region) {
+    jsize array_len = (*env)->GetArrayLength(env, region->array);
+    if (region->offset < 0 || region->length < 0 || region->offset > array_len - region->length) {
+        throw_exception(env, jni_cache.index_out_of_bounds_exception, "[Error OpenZL JNI] Array region out of bounds");
+        return 0;
     }
-    free(compressor);
+    return 1;
 }
 
 /**
- * Creates a new OpenZL decompressor instance.
- * Caller must call destroyDecompressor() to free the returned resource.
+ * region_acquire() without the bounds check, for windows already checked by the caller.
  */
-JNIEXPORT jlong JNICALL
-Java_net_openzl_OpenZLJNI_createDecompressor(JNIEnv *env, jclass clazz) {
-    openzl_decompressor_t *decompressor = malloc(sizeof(openzl_decompressor_t));
-    if (decompressor == NULL) {
-        throw_out_of_memory(env);
+static int region_map(JNIEnv *env, scratch_scope_t *scope, int critical,
+                      array_region_t *region, int copy_in) {
+    size_t width = array_kind_width(region->kind);
+    if (critical) {
+        region->pinned = (*env)->GetPrimitiveArrayCritical(env, region->array, NULL);
+        if (region->pinned == NULL) {
+            return -1;
+        }
+        region->data = (unsigned char *)region->pinned + (size_t)region->offset * width;
         return 0;
     }
     
-    decompressor->ctx = ZL_DCtx_create();
-    if (decompressor->ctx == NULL) {
-        free(decompressor);
-        throw_openzl_exception(env, "Failed to create decompression context");
+    region->pinned = NULL;
+    region->data = scratch_alloc(scope, (size_t)region->length * width);
+    if (region->data == NULL) {
+        return -1;
+    }
+    if (!copy_in) {
         return 0;
     }
-    
-    return (jlong)(uintptr_t)decompressor;
+    switch (region->kind) {
+        case ARRAY_INT:
+            (*env)->GetIntArrayRegion(env, (jintArray)region->array, region->offset, region->length, region->data);
+            break;
+        case ARRAY_LONG:
+            (*env)->GetLongArrayRegion(env, (jlongArray)region->array, region->offset, region->length, region->data);
+            break;
+        case ARRAY_FLOAT:
+            (*env)->GetFloatArrayRegion(env, (jfloatArray)region->array, region->offset, region->length, region->data);
+            break;
+        case ARRAY_DOUBLE:
+            (*env)->GetDoubleArrayRegion(env, (jdoubleArray)region->array, region->offset, region->length, region->data);
+            break;
+        case ARRAY_BYTE:
+        default:
+            (*env)->GetByteArrayRegion(env, (jbyteArray)region->array, region->offset, region->length, region->data);
+            break;
+    }
+    return (*env)->ExceptionCheck(env) ? -1 : 0;
 }
 
 /**
- * Frees a decompressor instance created by createDecompressor().
+ * Makes a region accessible at region->data. In copying mode the window is only read from
+ * the heap when copy_in is set, so output regions cost nothing up front.
+ * Returns 0 on success; on failure nothing is held and the caller must throw (see
+ * throw_region_failure), which is only legal once no other critical region is held. The
+ * bounds check calls into the JVM, so a second region pinned alongside a critical one must
+ * go through region_acquire_pair() instead.
  */
-JNIEXPORT void JNICALL
-Java_net_openzl_OpenZLJNI_destroyDecompressor(JNIEnv *env, jclass clazz, jlong decompressor_ptr) {
-    if (decompressor_ptr == 0) return;
-    
-    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
-    if (decompressor->ctx != NULL) {
-        ZL_DCtx_free(decompressor->ctx);
+static int region_acquire(JNIEnv *env, scratch_scope_t *scope, int critical,
+                          array_region_t *region, int copy_in) {
+    if (!region_in_bounds(env, region)) {
+        return -1;
     }
-    free(decompressor);
+    return region_map(env, scope, critical, region, copy_in);
 }
 
 /**
- * Compresses a segment of byte data and returns a new byte array with the compressed result.
- * Returns null and throws an exception on failure.
- * The compressor must not be shared across threads while in use.
+ * Releases a region acquired by region_acquire(). The first commit elements are written
+ * back to the array. A commit of 0 means the call failed: copying mode then skips the
+ * copy-back, but critical mode has been writing the heap in place all along, so the array
+ * may hold partial output either way.
  */
-JNIEXPORT jbyteArray JNICALL
-Java_net_openzl_OpenZLJNI_compressSerial(JNIEnv *env, jclass clazz, jlong compressor_ptr,
-                                        jbyteArray src, jint src_off, jint src_len) {
-    if (compressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
-        return NULL;
-    }
-    
-    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
-    
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    if (src_data == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
+static void region_release(JNIEnv *env, array_region_t *region, int critical, size_t commit) {
+    if (critical) {
+        (*env)->ReleasePrimitiveArrayCritical(env, region->array, region->pinned, commit != 0 ? 0 : JNI_ABORT);
+        return;
     }
-    
-    size_t max_compressed_size = ZL_compressBound(src_len);
-    
-    void *compressed_data = malloc(max_compressed_size);
-    if (compressed_data == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_out_of_memory(env);
-        return NULL;
+    if (commit == 0) {
+        return;
     }
-    
-    ZL_TypedRef* typed_ref = ZL_TypedRef_createSerial(src_data + src_off, src_len);
-    if (typed_ref == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        free(compressed_data);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference for serial data");
-        return NULL;
+    switch (region->kind) {
+        case ARRAY_INT:
+            (*env)->SetIntArrayRegion(env, (jintArray)region->array, region->offset, (jsize)commit, region->data);
+            break;
+        case ARRAY_LONG:
+            (*env)->SetLongArrayRegion(env, (jlongArray)region->array, region->offset, (jsize)commit, region->data);
+            break;
+        case ARRAY_FLOAT:
+            (*env)->SetFloatArrayRegion(env, (jfloatArray)region->array, region->offset, (jsize)commit, region->data);
+            break;
+        case ARRAY_DOUBLE:
+            (*env)->SetDoubleArrayRegion(env, (jdoubleArray)region->array, region->offset, (jsize)commit, region->data);
+            break;
+        case ARRAY_BYTE:
+        default:
+            (*env)->SetByteArrayRegion(env, (jbyteArray)region->array, region->offset, (jsize)commit, region->data);
+            break;
     }
+}
 
-    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
-        compressor->ctx,
-        compressed_data, max_compressed_size,
-        typed_ref
-    );
-
-    ZL_TypedRef_free(typed_ref);
-    
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-    
-    if (ZL_isError(compress_report)) {
-        free(compressed_data);
-        throw_openzl_report_error(env, compress_report);
-        return NULL;
+/**
+ * Acquires a source region (copied in) and a destination region (not copied in) together.
+ */
+static int region_acquire_pair(JNIEnv *env, scratch_scope_t *scope, int critical,
+                               array_region_t *src, array_region_t *dest) {
+    if (!region_in_bounds(env, src) || !region_in_bounds(env, dest)) {
+        return -1;
     }
-    
-    size_t compressed_size = ZL_validResult(compress_report);
-    
-    jbyteArray result = (*env)->NewByteArray(env, compressed_size);
-    if (result == NULL) {
-        free(compressed_data);
-        throw_out_of_memory(env);
-        return NULL;
+    if (region_map(env, scope, critical, src, 1) != 0) {
+        return -1;
     }
+    if (region_map(env, scope, critical, dest, 0) != 0) {
+        region_release(env, src, critical, 0);
+        return -1;
+    }
+    return 0;
+}
+
+static void throw_region_failure(JNIEnv *env) {
+    if (!(*env)->ExceptionCheck(env)) {
+        throw_out_of_memory(env);
+    }
+}
+
+/**
+ * Largest element count the JVM reliably allocates for a primitive array. Results beyond it
+ * are rejected explicitly rather than truncated to jsize; callers needing more go through
+ * the MemorySegment API.
+ */
+#define MAX_JAVA_ARRAY_LENGTH ((size_t)INT32_MAX - 8)
+
+static void throw_array_too_large(JNIEnv *env) {
+    throw_openzl_exception(env, "[Error OpenZL JNI] Result exceeds the maximum Java array size; use the MemorySegment API");
+}
+
+/**
+ * Creates a new Java array of the given kind holding count elements copied from data.
+ */
+static jarray new_array_from(JNIEnv *env, array_kind_t kind, jsize count, const void *data) {
+    jarray result;
+    switch (kind) {
+        case ARRAY_INT:
+            result = (*env)->NewIntArray(env, count);
+            if (result != NULL) (*env)->SetIntArrayRegion(env, (jintArray)result, 0, count, data);
+            break;
+        case ARRAY_LONG:
+            result = (*env)->NewLongArray(env, count);
+            if (result != NULL) (*env)->SetLongArrayRegion(env, (jlongArray)result, 0, count, data);
+            break;
+        case ARRAY_FLOAT:
+            result = (*env)->NewFloatArray(env, count);
+            if (result != NULL) (*env)->SetFloatArrayRegion(env, (jfloatArray)result, 0, count, data);
+            break;
+        case ARRAY_DOUBLE:
+            result = (*env)->NewDoubleArray(env, count);
+            if (result != NULL) (*env)->SetDoubleArrayRegion(env, (jdoubleArray)result, 0, count, data);
+            break;
+        case ARRAY_BYTE:
+        default:
+            result = (*env)->NewByteArray(env, count);
+            if (result != NULL) (*env)->SetByteArrayRegion(env, (jbyteArray)result, 0, count, data);
+            break;
+    }
+    return result;
+}
+
+typedef struct {
+    ZL_CCtx *ctx;
+    ZL_Compressor *compressor;
+    ZL_GraphID graph_id;
+} openzl_compressor_t;
+
+typedef struct {
+    ZL_DCtx *ctx;
+} openzl_decompressor_t;
+
+/**
+ * Number of CompressionGraph ids (0..9); unknown ids compress with ZSTD.
+ */
+#define GRAPH_SLOT_COUNT 10
+
+/**
+ * Compresses length elements of a Java array starting at offset into scratch memory and
+ * returns the result as a new byte array. elt_width is 0 for serial data, otherwise the
+ * numeric element width. The input is read in place when small enough to pin critically,
+ * and the output is copied once into the Java array.
+ */
+static jbyteArray compress_array(JNIEnv *env, scratch_scope_t *scope, openzl_compressor_t *compressor,
+                                 jarray array, array_kind_t kind, jsize offset, jsize length,
+                                 size_t elt_width) {
+    size_t input_size = (size_t)length * array_kind_width(kind);
+    size_t max_compressed_size = ZL_compressBound(input_size);
+    
+    void *compressed_data = scratch_alloc(scope, max_compressed_size);
+    if (compressed_data == NULL) {
+        throw_out_of_memory(env);
+        return NULL;
+    }
+    
+    int critical = use_critical_access(input_size, 0);
+    array_region_t region = { array, kind, offset, length, NULL, NULL };
+    if (region_acquire(env, scope, critical, &region, 1) != 0) {
+        throw_region_failure(env);
+        return NULL;
+    }
+    
+    ZL_TypedRef* typed_ref = elt_width != 0
+        ? ZL_TypedRef_createNumeric(region.data, elt_width, input_size / elt_width)
+        : ZL_TypedRef_createSerial(region.data, input_size);
+    if (typed_ref == NULL) {
+        region_release(env, &region, critical, 0);
+        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference");
+        return NULL;
+    }
+    
+    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
+        compressor->ctx,
+        compressed_data, max_compressed_size,
+        typed_ref
+    );
+    
+    ZL_TypedRef_free(typed_ref);
+    region_release(env, &region, critical, 0);
+    
+    if (ZL_isError(compress_report)) {
+        throw_openzl_report_error(env, compress_report);
+        return NULL;
+    }
+    
+    size_t compressed_size = ZL_validResult(compress_report);
+    if (compressed_size > MAX_JAVA_ARRAY_LENGTH) {
+        throw_array_too_large(env);
+        return NULL;
+    }
+    return (jbyteArray)new_array_from(env, ARRAY_BYTE, (jsize)compressed_size, compressed_data);
+}
+
+JNIEXPORT void JNICALL
+Java_net_openzl_OpenZLJNI_nativeInit(JNIEnv *env, jclass clazz) {
+    // Currently OpenZL doesn't require explicit initialization
+}
+
+/**
+ * Shuts down the OpenZL native library and performs cleanup operations.
+ * 
+ * This method provides symmetry with nativeInit() and allows for future cleanup
+ * operations if OpenZL introduces global state that needs to be released.
+ * Currently, OpenZL doesn't require explicit shutdown, but this method is
+ * provided for future-proofing and API completeness.
+ */
+ 
+JNIEXPORT void JNICALL
+Java_net_openzl_OpenZLJNI_nativeShutdown(JNIEnv *env, jclass clazz) {
+    // Currently OpenZL doesn't require explicit shutdown
+}
+
+/**
+ * Sets the combined array size up to which the *ToBuffer paths use critical array access.
+ * A threshold of 0 disables the critical path entirely.
+ */
+JNIEXPORT void JNICALL
+Java_net_openzl_OpenZLJNI_setCriticalArrayThreshold(JNIEnv *env, jclass clazz, jint threshold) {
+    critical_array_threshold = threshold < 0 ? 0 : threshold;
+}
+
+/**
+ * Sets the largest block, in bytes, a thread's scratch arena keeps between calls.
+ * Transient buffers above the limit are allocated and freed per call; 0 disables retention.
+ */
+JNIEXPORT void JNICALL
+Java_net_openzl_OpenZLJNI_setScratchArenaRetainLimit(JNIEnv *env, jclass clazz, jlong limit) {
+    scratch_retain_limit = limit < 0 ? 0 : limit;
+}
+
+/**
+ * Returns the scratch arena counters summed over all threads: live arenas, retained bytes,
+ * peak bytes used by a single call, allocations served by arenas, allocations that
+ * overflowed to the system allocator, and system allocations and frees.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_net_openzl_OpenZLJNI_getScratchArenaStats(JNIEnv *env, jclass clazz) {
+    long long stats[SCRATCH_STAT_COUNT + 1];
+    scratch_arena_stats(stats);
+    
+    jlong values[SCRATCH_STAT_COUNT + 1];
+    for (int i = 0; i < SCRATCH_STAT_COUNT + 1; i++) {
+        values[i] = (jlong)stats[i];
+    }
+    return (jlongArray)new_array_from(env, ARRAY_LONG, SCRATCH_STAT_COUNT + 1, values);
+}
+
+static jint graph_slot(jint graph_id) {
+    return graph_id >= 0 && graph_id < GRAPH_SLOT_COUNT ? graph_id : 0;
+}
+
+static ZL_GraphID graph_from_slot(jint slot) {
+    switch (slot) {
+        case 1:
+            return ZL_GRAPH_COMPRESS_GENERIC;
+        case 2:
+            return ZL_GRAPH_FIELD_LZ;
+        case 3:
+            return ZL_GRAPH_STORE;
+        case 4:
+            return ZL_GRAPH_FSE;
+        case 5:
+            return ZL_GRAPH_HUFFMAN;
+        case 6:
+            return ZL_GRAPH_ENTROPY;
+        case 7:
+            return ZL_GRAPH_BITPACK;
+        case 8:
+            return ZL_GRAPH_CONSTANT;
+        case 9:
+            return ZL_GRAPH_COMPRESS_GENERIC;
+        case 0:
+        default:
+            return ZL_GRAPH_ZSTD;
+    }
+}
+
+static void compressor_release(openzl_compressor_t *compressor) {
+    if (compressor->compressor != NULL) {
+        ZL_Compressor_free(compressor->compressor);
+        compressor->compressor = NULL;
+    }
+    if (compressor->ctx != NULL) {
+        ZL_CCtx_free(compressor->ctx);
+        compressor->ctx = NULL;
+    }
+}
+
+/**
+ * Creates the context and compressor of a handle for graph_id (see createCompressor).
+ * Returns 0 on success. On failure everything is released again and the error is left in
+ * *message, or in *report when OpenZL rejected a parameter (*message is then NULL).
+ */
+static int compressor_init(openzl_compressor_t *compressor, jint graph_id,
+                           const char **message, ZL_Report *report) {
+    compressor->compressor = NULL;
+    compressor->graph_id = graph_from_slot(graph_slot(graph_id));
+    
+    compressor->ctx = ZL_CCtx_create();
+    if (compressor->ctx == NULL) {
+        *message = "Failed to create compression context";
+        return -1;
+    }
+    
+    compressor->compressor = ZL_Compressor_create();
+    if (compressor->compressor == NULL) {
+        compressor_release(compressor);
+        *message = "Failed to create compressor object";
+        return -1;
+    }
+    
+    *message = NULL;
+    *report = ZL_CCtx_setParameter(compressor->ctx, ZL_CParam_formatVersion, ZL_MAX_FORMAT_VERSION);
+    if (!ZL_isError(*report)) {
+        *report = ZL_CCtx_setParameter(compressor->ctx, ZL_CParam_compressionLevel, ZL_COMPRESSIONLEVEL_DEFAULT);
+    }
+    if (!ZL_isError(*report)) {
+        *report = ZL_Compressor_selectStartingGraphID(compressor->compressor, compressor->graph_id);
+    }
+    if (!ZL_isError(*report)) {
+        *report = ZL_CCtx_refCompressor(compressor->ctx, compressor->compressor);
+    }
+    if (ZL_isError(*report)) {
+        compressor_release(compressor);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Creates a new OpenZL compressor configured with the specified built-in compression graph.
+ * 
+ * Graph ID mappings:
+ *   0, default: ZSTD (fallback)
+ *   1, 9       : Generic compressor (ZL_GRAPH_COMPRESS_GENERIC)
+ *   2          : FieldLZ (numeric/structured data)
+ *   3          : Store (no compression)
+ *   4          : FSE entropy coding
+ *   5          : Huffman coding
+ *   6          : General entropy coding
+ *   7          : Bitpacking
+ *   8          : Constant-value optimization
+ *
+ * Returns a native pointer to the compressor; caller must call destroyCompressor() to free it.
+ */
+
+JNIEXPORT jlong JNICALL
+Java_net_openzl_OpenZLJNI_createCompressor(JNIEnv *env, jclass clazz, jint graph_id) {
+    openzl_compressor_t *compressor = malloc(sizeof(openzl_compressor_t));
+    if (compressor == NULL) {
+        throw_out_of_memory(env);
+        return 0;
+    }
+    
+    const char *message;
+    ZL_Report report;
+    if (compressor_init(compressor, graph_id, &message, &report) != 0) {
+        free(compressor);
+        if (message != NULL) {
+            throw_openzl_exception(env, message);
+        } else {
+            throw_openzl_report_error(env, report);
+        }
+        return 0;
+    }
+    
+    return (jlong)(uintptr_t)compressor;
+}
+
+/**
+ * Frees a compressor instance created by createCompressor().
+ */
+JNIEXPORT void JNICALL
+Java_net_openzl_OpenZLJNI_destroyCompressor(JNIEnv *env, jclass clazz, jlong compressor_ptr) {
+    if (compressor_ptr == 0) return;
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    compressor_release(compressor);
+    free(compressor);
+}
+
+/**
+ * Creates a new OpenZL decompressor instance.
+ * Caller must call destroyDecompressor() to free the returned resource.
+ */
+JNIEXPORT jlong JNICALL
+Java_net_openzl_OpenZLJNI_createDecompressor(JNIEnv *env, jclass clazz) {
+    openzl_decompressor_t *decompressor = malloc(sizeof(openzl_decompressor_t));
+    if (decompressor == NULL) {
+        throw_out_of_memory(env);
+        return 0;
+    }
+    
+    decompressor->ctx = ZL_DCtx_create();
+    if (decompressor->ctx == NULL) {
+        free(decompressor);
+        throw_openzl_exception(env, "Failed to create decompression context");
+        return 0;
+    }
+    
+    return (jlong)(uintptr_t)decompressor;
+}
+
+/**
+ * Frees a decompressor instance created by createDecompressor().
+ */
+JNIEXPORT void JNICALL
+Java_net_openzl_OpenZLJNI_destroyDecompressor(JNIEnv *env, jclass clazz, jlong decompressor_ptr) {
+    if (decompressor_ptr == 0) return;
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    if (decompressor->ctx != NULL) {
+        ZL_DCtx_free(decompressor->ctx);
+    }
+    free(decompressor);
+}
+
+/**
+ * Plain C accessors for the FFM backend (net.openzl.OpenZLFFM), which drives the
+ * contexts owned by JNI-created handles through java.lang.foreign downcalls.
+ */
+JNIEXPORT ZL_CCtx *openzl_jni_compressor_cctx(jlong compressor_ptr) {
+    if (compressor_ptr == 0) return NULL;
+    return ((openzl_compressor_t *)(uintptr_t)compressor_ptr)->ctx;
+}
+
+JNIEXPORT ZL_DCtx *openzl_jni_decompressor_dctx(jlong decompressor_ptr) {
+    if (decompressor_ptr == 0) return NULL;
+    return ((openzl_decompressor_t *)(uintptr_t)decompressor_ptr)->ctx;
+}
+
+/**
+ * Compresses a segment of byte data and returns a new byte array with the compressed result.
+ * Returns null and throws an exception on failure.
+ * The compressor must not be shared across threads while in use.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_compressSerial(JNIEnv *env, jclass clazz, jlong compressor_ptr,
+                                        jbyteArray src, jint src_off, jint src_len) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return NULL;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jbyteArray result = compress_array(env, &scope, compressor, src, ARRAY_BYTE, src_off, src_len, 0);
+    scratch_end(&scope);
+    return result;
+}
+
+static jint compress_to_array(JNIEnv *env, scratch_scope_t *scope, openzl_compressor_t *compressor,
+                              jbyteArray src, jint src_off, jint src_len,
+                              jbyteArray dest, jint dest_off, jint max_dest_len) {
+    int critical = use_critical_access(src_len, max_dest_len);
+    array_region_t src_region = { src, ARRAY_BYTE, src_off, src_len, NULL, NULL };
+    array_region_t dest_region = { dest, ARRAY_BYTE, dest_off, max_dest_len, NULL, NULL };
+    if (region_acquire_pair(env, scope, critical, &src_region, &dest_region) != 0) {
+        throw_region_failure(env);
+        return -1;
+    }
+    
+    ZL_TypedRef* typed_ref = ZL_TypedRef_createSerial(src_region.data, src_len);
+    if (typed_ref == NULL) {
+        region_release(env, &dest_region, critical, 0);
+        region_release(env, &src_region, critical, 0);
+        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference");
+        return -1;
+    }
+    
+    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
+        compressor->ctx,
+        dest_region.data, max_dest_len,
+        typed_ref
+    );
+    
+    ZL_TypedRef_free(typed_ref);
+    
+    size_t compressed_size = ZL_isError(compress_report) ? 0 : ZL_validResult(compress_report);
+    region_release(env, &dest_region, critical, compressed_size);
+    region_release(env, &src_region, critical, 0);
+    
+    if (ZL_isError(compress_report)) {
+        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(compress_report)));
+        return -1;
+    }
+    
+    return (jint)compressed_size;
+}
+
+/**
+ * Compresses a segment of byte data directly into a pre-allocated destination buffer.
+ * Returns the actual compressed size on success, or -1 if an error occurs (exception thrown).
+ * The destination buffer must be large enough—use compressBound() to determine required size.
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_compressSerialToBuffer(JNIEnv *env, jclass clazz, jlong compressor_ptr,
+                                                jbyteArray src, jint src_off, jint src_len,
+                                                jbyteArray dest, jint dest_off, jint max_dest_len) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return -1;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jint result = compress_to_array(env, &scope, compressor, src, src_off, src_len, dest, dest_off, max_dest_len);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Compresses a region of a direct ByteBuffer straight into another direct ByteBuffer.
+ * Both buffers are accessed in place through GetDirectBufferAddress, so no Java heap
+ * copies are made. Positions are resolved on the Java side, which also advances them.
+ * Returns the compressed size on success, or -1 if an error occurs (exception thrown).
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_compressDirect(JNIEnv *env, jclass clazz, jlong compressor_ptr,
+                                        jobject src, jint src_pos, jint src_len,
+                                        jobject dest, jint dest_pos, jint max_dest_len) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return -1;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    
+    jbyte *src_data = (*env)->GetDirectBufferAddress(env, src);
+    jbyte *dest_data = (*env)->GetDirectBufferAddress(env, dest);
+    if (src_data == NULL || dest_data == NULL) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Buffer is not a direct buffer");
+        return -1;
+    }
+    
+    ZL_TypedRef* typed_ref = ZL_TypedRef_createSerial(src_data + src_pos, src_len);
+    if (typed_ref == NULL) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference");
+        return -1;
+    }
+    
+    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
+        compressor->ctx,
+        dest_data + dest_pos, max_dest_len,
+        typed_ref
+    );
+    
+    ZL_TypedRef_free(typed_ref);
+    
+    if (ZL_isError(compress_report)) {
+        throw_openzl_report_error(env, compress_report);
+        return -1;
+    }
+    
+    return (jint)ZL_validResult(compress_report);
+}
+
+static int is_numeric_width(jint element_size) {
+    return element_size == 1 || element_size == 2 || element_size == 4 || element_size == 8;
+}
+
+/**
+ * Compresses a byte array holding packed numeric elements of 1, 2, 4 or 8 bytes each
+ * (e.g. uint8/uint16 samples) using OpenZL's numeric compression pipeline.
+ * The elements are read in place from the Java array in native byte order.
+ * Returns a new byte array with the compressed data, or throws an exception on failure.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_compressNumeric(JNIEnv *env, jclass clazz, jlong compressor_ptr,
+                                         jbyteArray data, jint element_size, jint element_count) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return NULL;
+    }
+    if (!is_numeric_width(element_size)) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Element size must be 1, 2, 4 or 8");
+        return NULL;
+    }
+    if ((jlong)element_size * element_count > (*env)->GetArrayLength(env, data)) {
+        throw_exception(env, jni_cache.index_out_of_bounds_exception, "[Error OpenZL JNI] Element count exceeds array length");
+        return NULL;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jbyteArray result = compress_array(env, &scope, compressor, data, ARRAY_BYTE, 0, element_size * element_count, element_size);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Compresses a Java int array using OpenZL's numeric compression pipeline.
+ * Treats the data as 32-bit signed integers for improved compression efficiency.
+ * Returns a new byte array containing the compressed data, or throws an exception on failure.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_compressNumericInts(JNIEnv *env, jclass clazz, jlong compressor_ptr, jintArray data) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return NULL;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    jsize array_len = (*env)->GetArrayLength(env, data);
+    scratch_scope_t scope = scratch_begin();
+    jbyteArray result = compress_array(env, &scope, compressor, data, ARRAY_INT, 0, array_len, sizeof(jint));
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Compresses a Java long array using OpenZL's numeric compression pipeline.
+ * Treats the data as an array of 64-bit signed integers (jlong) for optimized compression.
+ * Returns a new byte array with the compressed data, or throws an exception on failure.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_compressNumericLongs(JNIEnv *env, jclass clazz, jlong compressor_ptr, jlongArray data) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return NULL;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    jsize array_len = (*env)->GetArrayLength(env, data);
+    scratch_scope_t scope = scratch_begin();
+    jbyteArray result = compress_array(env, &scope, compressor, data, ARRAY_LONG, 0, array_len, sizeof(jlong));
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Compresses a Java float array by treating its binary representation as numeric data.
+ * Returns a new byte array with compressed data, or throws an exception on failure.
+ * Optimized for 32-bit floats using OpenZL's numeric compression pipeline.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_compressNumericFloats(JNIEnv *env, jclass clazz, jlong compressor_ptr, jfloatArray data) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return NULL;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    jsize array_len = (*env)->GetArrayLength(env, data);
+    scratch_scope_t scope = scratch_begin();
+    jbyteArray result = compress_array(env, &scope, compressor, data, ARRAY_FLOAT, 0, array_len, sizeof(jfloat));
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Compresses a Java double array using OpenZL's numeric compression pipeline.
+ * Treats the data as an array of 64-bit floating-point values for optimized compression.
+ * Returns a new byte array with the compressed data, or throws an exception on failure.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_compressNumericDoubles(JNIEnv *env, jclass clazz, jlong compressor_ptr, jdoubleArray data) {
+    if (compressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+        return NULL;
+    }
+    
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    jsize array_len = (*env)->GetArrayLength(env, data);
+    scratch_scope_t scope = scratch_begin();
+    jbyteArray result = compress_array(env, &scope, compressor, data, ARRAY_DOUBLE, 0, array_len, sizeof(jdouble));
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Decompresses a frame into scratch memory sized from its header and returns the output
+ * as a new array of the given kind. For numeric kinds the frame's element width must
+ * match the array's.
+ */
+static jarray decompress_to_new_array(JNIEnv *env, scratch_scope_t *scope, openzl_decompressor_t *decompressor,
+                                      jbyteArray src, jint src_off, jint src_len, array_kind_t kind) {
+    int critical = use_critical_access(src_len, 0);
+    array_region_t src_region = { src, ARRAY_BYTE, src_off, src_len, NULL, NULL };
+    if (region_acquire(env, scope, critical, &src_region, 1) != 0) {
+        throw_region_failure(env);
+        return NULL;
+    }
+    
+    ZL_Report size_report = ZL_getDecompressedSize(src_region.data, src_len);
+    if (ZL_isError(size_report)) {
+        region_release(env, &src_region, critical, 0);
+        throw_openzl_report_error(env, size_report);
+        return NULL;
+    }
+    
+    size_t decompressed_size = ZL_validResult(size_report);
+    size_t elt_width = array_kind_width(kind);
+    if (decompressed_size / elt_width > MAX_JAVA_ARRAY_LENGTH) {
+        region_release(env, &src_region, critical, 0);
+        throw_array_too_large(env);
+        return NULL;
+    }
+    
+    void *decompressed_data = scratch_alloc(scope, decompressed_size);
+    if (decompressed_data == NULL) {
+        region_release(env, &src_region, critical, 0);
+        throw_out_of_memory(env);
+        return NULL;
+    }
+    
+    ZL_OutputInfo outputInfo;
+    ZL_Report decompress_report = kind == ARRAY_BYTE
+        ? ZL_DCtx_decompress(decompressor->ctx, decompressed_data, decompressed_size, src_region.data, src_len)
+        : ZL_DCtx_decompressTyped(decompressor->ctx, &outputInfo, decompressed_data, decompressed_size,
+                                  src_region.data, src_len);
+    
+    region_release(env, &src_region, critical, 0);
+    
+    if (ZL_isError(decompress_report)) {
+        throw_openzl_report_error(env, decompress_report);
+        return NULL;
+    }
+    if (kind != ARRAY_BYTE && outputInfo.fixedWidth != elt_width) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Frame element width does not match the destination array");
+        return NULL;
+    }
+    
+    size_t count = kind == ARRAY_BYTE ? ZL_validResult(decompress_report) : outputInfo.numElts;
+    jarray result = new_array_from(env, kind, (jsize)count, decompressed_data);
+    if (result == NULL) {
+        throw_region_failure(env);
+    }
+    return result;
+}
+
+/**
+ * Decompresses serial (byte array) data compressed with OpenZL.
+ * Runs on the instance's ZL_DCtx so its workspace is reused across calls.
+ * Returns a new Java byte array containing the original uncompressed data.
+ * Throws an exception on failure (e.g., corrupted input or invalid format).
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_decompressSerial(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+                                          jbyteArray src, jint src_off, jint src_len) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return NULL;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jarray result = decompress_to_new_array(env, &scope, decompressor, src, src_off, src_len, ARRAY_BYTE);
+    scratch_end(&scope);
+    return (jbyteArray)result;
+}
+
+static jint decompress_to_array(JNIEnv *env, scratch_scope_t *scope, openzl_decompressor_t *decompressor,
+                                jbyteArray src, jint src_off, jint src_len,
+                                jbyteArray dest, jint dest_off, jint max_dest_len) {
+    int critical = use_critical_access(src_len, max_dest_len);
+    array_region_t src_region = { src, ARRAY_BYTE, src_off, src_len, NULL, NULL };
+    array_region_t dest_region = { dest, ARRAY_BYTE, dest_off, max_dest_len, NULL, NULL };
+    if (region_acquire_pair(env, scope, critical, &src_region, &dest_region) != 0) {
+        throw_region_failure(env);
+        return -1;
+    }
+    
+    ZL_Report decompress_report = ZL_DCtx_decompress(
+        decompressor->ctx,
+        dest_region.data, max_dest_len,
+        src_region.data, src_len
+    );
     
-    (*env)->SetByteArrayRegion(env, result, 0, compressed_size, (jbyte *)compressed_data);
-    free(compressed_data);
+    size_t decompressed_size = ZL_isError(decompress_report) ? 0 : ZL_validResult(decompress_report);
+    region_release(env, &dest_region, critical, decompressed_size);
+    region_release(env, &src_region, critical, 0);
     
-    return result;
+    if (ZL_isError(decompress_report)) {
+        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(decompress_report)));
+        return -1;
+    }
+    
+    return (jint)decompressed_size;
 }
 
 /**
- * Compresses a segment of byte data directly into a pre-allocated destination buffer.
- * Returns the actual compressed size on success, or -1 if an error occurs (exception thrown).
- * The destination buffer must be large enough—use compressBound() to determine required size.
+ * Decompresses OpenZL-compressed byte data directly into a pre-allocated destination buffer.
+ * Runs on the instance's ZL_DCtx so its workspace is reused across calls.
+ * Returns the actual decompressed size on success, or -1 if an error occurs (exception thrown).
+ * The destination buffer must be large enough to hold the full decompressed output.
  */
 JNIEXPORT jint JNICALL
-Java_net_openzl_OpenZLJNI_compressSerialToBuffer(JNIEnv *env, jclass clazz, jlong compressor_ptr,
-                                                jbyteArray src, jint src_off, jint src_len,
-                                                jbyteArray dest, jint dest_off, jint max_dest_len) {
-    if (compressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
+Java_net_openzl_OpenZLJNI_decompressSerialToBuffer(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+                                                  jbyteArray src, jint src_off, jint src_len,
+                                                  jbyteArray dest, jint dest_off, jint max_dest_len) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
         return -1;
     }
     
-    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jint result = decompress_to_array(env, &scope, decompressor, src, src_off, src_len, dest, dest_off, max_dest_len);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Decompresses a region of a direct ByteBuffer straight into another direct ByteBuffer.
+ * Runs on the instance's ZL_DCtx and touches only off-heap memory.
+ * Returns the decompressed size on success, or -1 if an error occurs (exception thrown).
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_decompressDirect(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+                                          jobject src, jint src_pos, jint src_len,
+                                          jobject dest, jint dest_pos, jint max_dest_len) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return -1;
+    }
     
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    jbyte *dest_data = (*env)->GetByteArrayElements(env, dest, NULL);
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
     
+    jbyte *src_data = (*env)->GetDirectBufferAddress(env, src);
+    jbyte *dest_data = (*env)->GetDirectBufferAddress(env, dest);
     if (src_data == NULL || dest_data == NULL) {
-        if (src_data) (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        if (dest_data) (*env)->ReleaseByteArrayElements(env, dest, dest_data, JNI_ABORT);
-        throw_out_of_memory(env);
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Buffer is not a direct buffer");
         return -1;
     }
     
-    ZL_TypedRef* typed_ref = ZL_TypedRef_createSerial(src_data + src_off, src_len);
-    if (typed_ref == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        (*env)->ReleaseByteArrayElements(env, dest, dest_data, JNI_ABORT);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference");
+    ZL_Report decompress_report = ZL_DCtx_decompress(
+        decompressor->ctx,
+        dest_data + dest_pos, max_dest_len,
+        src_data + src_pos, src_len
+    );
+    
+    if (ZL_isError(decompress_report)) {
+        throw_openzl_report_error(env, decompress_report);
         return -1;
     }
+    
+    return (jint)ZL_validResult(decompress_report);
+}
 
-    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
-        compressor->ctx,
-        dest_data + dest_off, max_dest_len,
-        typed_ref
+/**
+ * Decompresses a numeric frame into the byte array result, which must hold exactly
+ * element_size * expected_count bytes. Returns 0 on success, or -1 with an exception thrown.
+ */
+static int decompress_packed_numeric(JNIEnv *env, scratch_scope_t *scope, openzl_decompressor_t *decompressor,
+                                     jbyteArray src, jbyteArray result, jint element_size, jint expected_count) {
+    jsize src_len = (*env)->GetArrayLength(env, src);
+    jsize expected_size = element_size * expected_count;
+    int critical = use_critical_access(src_len, expected_size);
+    array_region_t src_region = { src, ARRAY_BYTE, 0, src_len, NULL, NULL };
+    array_region_t dest_region = { result, ARRAY_BYTE, 0, expected_size, NULL, NULL };
+    if (region_acquire_pair(env, scope, critical, &src_region, &dest_region) != 0) {
+        throw_region_failure(env);
+        return -1;
+    }
+    
+    ZL_OutputInfo outputInfo;
+    ZL_Report decompress_report = ZL_DCtx_decompressTyped(
+        decompressor->ctx,
+        &outputInfo,
+        dest_region.data, expected_size,
+        src_region.data, src_len
+    );
+    
+    int ok = !ZL_isError(decompress_report)
+        && outputInfo.fixedWidth == (uint32_t)element_size
+        && outputInfo.numElts == (size_t)expected_count;
+    region_release(env, &dest_region, critical, ok ? (size_t)expected_size : 0);
+    region_release(env, &src_region, critical, 0);
+    
+    if (ZL_isError(decompress_report)) {
+        throw_openzl_report_error(env, decompress_report);
+        return -1;
+    }
+    if (!ok) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Frame does not match the expected element size and count");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data into a new byte array of packed elements.
+ * The frame must hold element_size-wide numeric data with exactly expected_count elements.
+ * Small outputs are decompressed straight into the pinned Java array; larger ones are
+ * staged in the thread's scratch arena.
+ * Returns the new byte array, or throws an exception on failure.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumeric(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+                                           jbyteArray src, jint element_size, jint expected_count) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return NULL;
+    }
+    if (!is_numeric_width(element_size)) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Element size must be 1, 2, 4 or 8");
+        return NULL;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    
+    jlong expected_size = (jlong)element_size * expected_count;
+    if (expected_size > (jlong)MAX_JAVA_ARRAY_LENGTH) {
+        throw_array_too_large(env);
+        return NULL;
+    }
+    
+    jbyteArray result = (*env)->NewByteArray(env, (jsize)expected_size);
+    if (result == NULL) {
+        return NULL;
+    }
+    
+    scratch_scope_t scope = scratch_begin();
+    int status = decompress_packed_numeric(env, &scope, decompressor, src, result, element_size, expected_count);
+    scratch_end(&scope);
+    return status == 0 ? result : NULL;
+}
+
+/**
+ * Decompresses a numeric frame straight into a caller-provided primitive array starting
+ * at element dest_off. The frame's element width must equal the array's and its elements
+ * must fit in the rest of the array. Returns the element count, or -1 on error.
+ */
+static jint decompress_into_array(JNIEnv *env, scratch_scope_t *scope, openzl_decompressor_t *decompressor,
+                                  jbyteArray src, jint src_off, jint src_len,
+                                  jarray dest, array_kind_t kind, jint dest_off) {
+    jsize dest_len = (*env)->GetArrayLength(env, dest);
+    if (dest_off < 0 || dest_off > dest_len) {
+        throw_exception(env, jni_cache.index_out_of_bounds_exception, "[Error OpenZL JNI] Invalid destination offset");
+        return -1;
+    }
+    size_t elt_width = array_kind_width(kind);
+    size_t capacity = (size_t)(dest_len - dest_off) * elt_width;
+    
+    int critical = use_critical_access(src_len, capacity);
+    array_region_t src_region = { src, ARRAY_BYTE, src_off, src_len, NULL, NULL };
+    array_region_t dest_region = { dest, kind, dest_off, dest_len - dest_off, NULL, NULL };
+    if (region_acquire_pair(env, scope, critical, &src_region, &dest_region) != 0) {
+        throw_region_failure(env);
+        return -1;
+    }
+    
+    ZL_OutputInfo outputInfo;
+    ZL_Report decompress_report = ZL_DCtx_decompressTyped(
+        decompressor->ctx,
+        &outputInfo,
+        dest_region.data, capacity,
+        src_region.data, src_len
     );
+    
+    int ok = !ZL_isError(decompress_report) && outputInfo.fixedWidth == elt_width;
+    region_release(env, &dest_region, critical, ok ? outputInfo.numElts : 0);
+    region_release(env, &src_region, critical, 0);
+    
+    if (ZL_isError(decompress_report)) {
+        throw_openzl_report_error(env, decompress_report);
+        return -1;
+    }
+    if (!ok) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Frame element width does not match the destination array");
+        return -1;
+    }
+    
+    return (jint)outputInfo.numElts;
+}
 
-    ZL_TypedRef_free(typed_ref);
+/**
+ * Decompresses OpenZL-compressed numeric data back into a Java int array.
+ * Expects the original data to have been compressed as 32-bit signed integers.
+ * Returns a new int array with the decompressed values, or throws an exception on failure.
+ */
+JNIEXPORT jintArray JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericInts(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return NULL;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    jsize src_len = (*env)->GetArrayLength(env, src);
+    scratch_scope_t scope = scratch_begin();
+    jarray result = decompress_to_new_array(env, &scope, decompressor, src, 0, src_len, ARRAY_INT);
+    scratch_end(&scope);
+    return (jintArray)result;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data back into a Java long array.
+ * Expects the original data to have been compressed as 64-bit signed integers.
+ * Returns a new long array with the decompressed values, or throws an exception on failure.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericLongs(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return NULL;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    jsize src_len = (*env)->GetArrayLength(env, src);
+    scratch_scope_t scope = scratch_begin();
+    jarray result = decompress_to_new_array(env, &scope, decompressor, src, 0, src_len, ARRAY_LONG);
+    scratch_end(&scope);
+    return (jlongArray)result;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data back into a Java float array.
+ * Expects the original data to have been compressed as 32-bit floating-point values.
+ * Returns a new float array with the decompressed values, or throws an exception on failure.
+ */
+JNIEXPORT jfloatArray JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericFloats(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return NULL;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    jsize src_len = (*env)->GetArrayLength(env, src);
+    scratch_scope_t scope = scratch_begin();
+    jarray result = decompress_to_new_array(env, &scope, decompressor, src, 0, src_len, ARRAY_FLOAT);
+    scratch_end(&scope);
+    return (jfloatArray)result;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data back into a Java double array.
+ * Expects the original data to have been compressed as 64-bit floating-point values.
+ * Returns a new double array with the decompressed values, or throws an exception on failure.
+ */
+JNIEXPORT jdoubleArray JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericDoubles(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return NULL;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    jsize src_len = (*env)->GetArrayLength(env, src);
+    scratch_scope_t scope = scratch_begin();
+    jarray result = decompress_to_new_array(env, &scope, decompressor, src, 0, src_len, ARRAY_DOUBLE);
+    scratch_end(&scope);
+    return (jdoubleArray)result;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data into an existing Java int array at dest_off.
+ * Returns the number of elements written, or throws an exception on failure.
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericIntsInto(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+        jbyteArray src, jint src_off, jint src_len, jintArray dest, jint dest_off) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return -1;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jint result = decompress_into_array(env, &scope, decompressor, src, src_off, src_len, dest, ARRAY_INT, dest_off);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data into an existing Java long array at dest_off.
+ * Returns the number of elements written, or throws an exception on failure.
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericLongsInto(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+        jbyteArray src, jint src_off, jint src_len, jlongArray dest, jint dest_off) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return -1;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jint result = decompress_into_array(env, &scope, decompressor, src, src_off, src_len, dest, ARRAY_LONG, dest_off);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data into an existing Java float array at dest_off.
+ * Returns the number of elements written, or throws an exception on failure.
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericFloatsInto(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+        jbyteArray src, jint src_off, jint src_len, jfloatArray dest, jint dest_off) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return -1;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jint result = decompress_into_array(env, &scope, decompressor, src, src_off, src_len, dest, ARRAY_FLOAT, dest_off);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Decompresses OpenZL-compressed numeric data into an existing Java double array at dest_off.
+ * Returns the number of elements written, or throws an exception on failure.
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_decompressNumericDoublesInto(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+        jbyteArray src, jint src_off, jint src_len, jdoubleArray dest, jint dest_off) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return -1;
+    }
+    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jint result = decompress_into_array(env, &scope, decompressor, src, src_off, src_len, dest, ARRAY_DOUBLE, dest_off);
+    scratch_end(&scope);
+    return result;
+}
+
+
+/**
+ * One input of a compression batch: a window of a byte[] or of a direct ByteBuffer.
+ */
+typedef struct {
+    jobject object;
+    jbyte *direct;
+    jint offset;
+    jint length;
+} batch_item_t;
+
+/**
+ * Resolves element i of srcs. Without offs / lens the whole array or buffer is used.
+ * Returns 0 on success; on failure an exception is pending.
+ */
+static int batch_item(JNIEnv *env, jobjectArray srcs, const jint *offs, const jint *lens, jsize i,
+                      batch_item_t *item) {
+    item->object = (*env)->GetObjectArrayElement(env, srcs, i);
+    if (item->object == NULL) {
+        if (!(*env)->ExceptionCheck(env)) {
+            throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Batch entry cannot be null");
+        }
+        return -1;
+    }
+    
+    jlong capacity;
+    if ((*env)->IsInstanceOf(env, item->object, jni_cache.byte_array)) {
+        item->direct = NULL;
+        capacity = (*env)->GetArrayLength(env, (jarray)item->object);
+    } else {
+        item->direct = (*env)->GetDirectBufferAddress(env, item->object);
+        capacity = (*env)->GetDirectBufferCapacity(env, item->object);
+        if (item->direct == NULL || capacity < 0) {
+            (*env)->DeleteLocalRef(env, item->object);
+            throw_exception(env, jni_cache.illegal_argument_exception,
+                            "[Error OpenZL JNI] Batch entry must be a byte array or a direct buffer");
+            return -1;
+        }
+    }
+    
+    item->offset = offs != NULL ? offs[i] : 0;
+    item->length = lens != NULL ? lens[i] : (jint)(capacity > INT32_MAX ? INT32_MAX : capacity);
+    if (item->offset < 0 || item->length < 0 || (jlong)item->offset + item->length > capacity) {
+        (*env)->DeleteLocalRef(env, item->object);
+        throw_exception(env, jni_cache.index_out_of_bounds_exception, "[Error OpenZL JNI] Invalid offset or length");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Copies an optional int[] of exactly count elements into scratch memory. *out stays NULL
+ * for a null array. Returns 0 on success; on failure an exception is pending.
+ */
+static int batch_ints(JNIEnv *env, scratch_scope_t *scope, jintArray array, jsize count, jint **out) {
+    *out = NULL;
+    if (array == NULL) {
+        return 0;
+    }
+    if ((*env)->GetArrayLength(env, array) != count) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Batch arrays differ in length");
+        return -1;
+    }
+    array_region_t region = { array, ARRAY_INT, 0, count, NULL, NULL };
+    if (region_acquire(env, scope, 0, &region, 1) != 0) {
+        throw_region_failure(env);
+        return -1;
+    }
+    *out = region.data;
+    return 0;
+}
+
+static jbyteArray compress_batch(JNIEnv *env, scratch_scope_t *scope, openzl_compressor_t *compressor,
+                                 jobjectArray srcs, jintArray src_offs, jintArray src_lens,
+                                 jintArray dest_offsets) {
+    jsize count = (*env)->GetArrayLength(env, srcs);
+    if ((*env)->GetArrayLength(env, dest_offsets) != count + 1) {
+        throw_exception(env, jni_cache.illegal_argument_exception,
+                        "[Error OpenZL JNI] Offsets array must have one more entry than the batch");
+        return NULL;
+    }
+    
+    jint *offs;
+    jint *lens;
+    if (batch_ints(env, scope, src_offs, count, &offs) != 0 || batch_ints(env, scope, src_lens, count, &lens) != 0) {
+        return NULL;
+    }
     
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-    (*env)->ReleaseByteArrayElements(env, dest, dest_data, 0);
+    size_t bound = 0;
+    for (jsize i = 0; i < count; i++) {
+        batch_item_t item;
+        if (batch_item(env, srcs, offs, lens, i, &item) != 0) {
+            return NULL;
+        }
+        (*env)->DeleteLocalRef(env, item.object);
+        bound += ZL_compressBound((size_t)item.length);
+    }
     
-    if (ZL_isError(compress_report)) {
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(compress_report)));
-        return -1;
+    jint *offsets = scratch_alloc(scope, ((size_t)count + 1) * sizeof(jint));
+    uint8_t *out = scratch_alloc(scope, bound);
+    if (offsets == NULL || out == NULL) {
+        throw_out_of_memory(env);
+        return NULL;
     }
     
-    size_t compressed_size = ZL_validResult(compress_report);
-    return (jint)compressed_size;
+    size_t pos = 0;
+    for (jsize i = 0; i < count; i++) {
+        batch_item_t item;
+        if (batch_item(env, srcs, offs, lens, i, &item) != 0) {
+            return NULL;
+        }
+        
+        scratch_scope_t item_scope = scratch_begin();
+        int critical = 0;
+        array_region_t region = { (jarray)item.object, ARRAY_BYTE, item.offset, item.length, NULL, NULL };
+        const void *data;
+        if (item.direct != NULL) {
+            data = item.direct + item.offset;
+        } else {
+            critical = use_critical_access((size_t)item.length, 0);
+            if (region_acquire(env, &item_scope, critical, &region, 1) != 0) {
+                scratch_end(&item_scope);
+                (*env)->DeleteLocalRef(env, item.object);
+                throw_region_failure(env);
+                return NULL;
+            }
+            data = region.data;
+        }
+        
+        ZL_Report report = ZL_CCtx_compress(compressor->ctx, out + pos, bound - pos, data, (size_t)item.length);
+        
+        if (item.direct == NULL) {
+            region_release(env, &region, critical, 0);
+        }
+        scratch_end(&item_scope);
+        (*env)->DeleteLocalRef(env, item.object);
+        
+        if (ZL_isError(report)) {
+            throw_openzl_report_error(env, report);
+            return NULL;
+        }
+        offsets[i] = (jint)pos;
+        pos += ZL_validResult(report);
+        if (pos > MAX_JAVA_ARRAY_LENGTH) {
+            throw_array_too_large(env);
+            return NULL;
+        }
+    }
+    offsets[count] = (jint)pos;
+    
+    (*env)->SetIntArrayRegion(env, dest_offsets, 0, count + 1, offsets);
+    if ((*env)->ExceptionCheck(env)) {
+        return NULL;
+    }
+    jbyteArray result = (jbyteArray)new_array_from(env, ARRAY_BYTE, (jsize)pos, out);
+    if (result == NULL) {
+        throw_region_failure(env);
+    }
+    return result;
 }
 
 /**
- * Compresses a Java int array using OpenZL's numeric compression pipeline.
- * Treats the data as 32-bit signed integers for improved compression efficiency.
- * Returns a new byte array containing the compressed data, or throws an exception on failure.
+ * Compresses every entry of srcs (each a byte[] or a direct ByteBuffer) into its own frame
+ * with one JNI transition and the instance's ZL_CCtx. Entry i is the window
+ * [srcOffs[i], srcOffs[i] + srcLens[i]); both arrays may be null to use whole entries.
+ * The frames are returned back to back in one array, frame i spanning
+ * [destOffsets[i], destOffsets[i + 1]), and destOffsets must hold srcs.length + 1 entries.
+ * Returns null and throws an exception on failure.
  */
 JNIEXPORT jbyteArray JNICALL
-Java_net_openzl_OpenZLJNI_compressNumericInts(JNIEnv *env, jclass clazz, jlong compressor_ptr, jintArray data) {
+Java_net_openzl_OpenZLJNI_compressBatch(JNIEnv *env, jclass clazz, jlong compressor_ptr,
+                                       jobjectArray srcs, jintArray src_offs, jintArray src_lens,
+                                       jintArray dest_offsets) {
     if (compressor_ptr == 0) {
         throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
         return NULL;
     }
-    
-    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
-    
-    jsize array_len = (*env)->GetArrayLength(env, data);
-    jint *array_data = (*env)->GetIntArrayElements(env, data, NULL);
-    
-    if (array_data == NULL) {
-        throw_out_of_memory(env);
+    if (srcs == NULL || dest_offsets == NULL) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Batch arrays cannot be null");
         return NULL;
     }
     
-    size_t input_size = array_len * sizeof(jint);
-    size_t max_compressed_size = ZL_compressBound(input_size);
-    
-    void *compressed_data = malloc(max_compressed_size);
-    if (compressed_data == NULL) {
-        (*env)->ReleaseIntArrayElements(env, data, array_data, JNI_ABORT);
-        throw_out_of_memory(env);
+    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jbyteArray result = compress_batch(env, &scope, compressor, srcs, src_offs, src_lens, dest_offsets);
+    scratch_end(&scope);
+    return result;
+}
+
+static jobjectArray decompress_batch(JNIEnv *env, scratch_scope_t *scope, openzl_decompressor_t *decompressor,
+                                     jbyteArray src, jintArray src_offsets) {
+    jsize src_len = (*env)->GetArrayLength(env, src);
+    jsize entries = (*env)->GetArrayLength(env, src_offsets);
+    if (entries < 1) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Offsets array cannot be empty");
         return NULL;
     }
+    jsize count = entries - 1;
     
-    ZL_TypedRef* typed_ref = ZL_TypedRef_createNumeric(array_data, sizeof(jint), array_len);
-    if (typed_ref == NULL) {
-        (*env)->ReleaseIntArrayElements(env, data, array_data, JNI_ABORT);
-        free(compressed_data);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference for numeric data");
+    jint *offsets;
+    if (batch_ints(env, scope, src_offsets, entries, &offsets) != 0) {
         return NULL;
     }
+    for (jsize i = 0; i < count; i++) {
+        if (offsets[i] < 0 || offsets[i] > offsets[i + 1] || offsets[i + 1] > src_len) {
+            throw_exception(env, jni_cache.index_out_of_bounds_exception, "[Error OpenZL JNI] Invalid batch offsets");
+            return NULL;
+        }
+    }
     
-    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
-        compressor->ctx,
-        compressed_data, max_compressed_size,
-        typed_ref
-    );
-    
-    ZL_TypedRef_free(typed_ref);
-    (*env)->ReleaseIntArrayElements(env, data, array_data, JNI_ABORT);
-    
-    if (ZL_isError(compress_report)) {
-        free(compressed_data);
-        throw_openzl_report_error(env, compress_report);
+    // New arrays are allocated between frames, so the input is copied once rather than pinned.
+    array_region_t src_region = { src, ARRAY_BYTE, 0, src_len, NULL, NULL };
+    if (region_acquire(env, scope, 0, &src_region, 1) != 0) {
+        throw_region_failure(env);
         return NULL;
     }
+    const uint8_t *data = src_region.data;
     
-    size_t compressed_size = ZL_validResult(compress_report);
-    
-    jbyteArray result = (*env)->NewByteArray(env, compressed_size);
+    jobjectArray result = (*env)->NewObjectArray(env, count, jni_cache.byte_array, NULL);
     if (result == NULL) {
-        free(compressed_data);
-        throw_out_of_memory(env);
+        throw_region_failure(env);
+        return NULL;
+    }
+    
+    for (jsize i = 0; i < count; i++) {
+        const uint8_t *frame = data + offsets[i];
+        size_t frame_len = (size_t)(offsets[i + 1] - offsets[i]);
+        ZL_Report size_report = ZL_getDecompressedSize(frame, frame_len);
+        if (ZL_isError(size_report)) {
+            throw_openzl_report_error(env, size_report);
+            return NULL;
+        }
+        size_t decompressed_size = ZL_validResult(size_report);
+        if (decompressed_size > MAX_JAVA_ARRAY_LENGTH) {
+            throw_array_too_large(env);
+            return NULL;
+        }
+        
+        jbyteArray entry = (*env)->NewByteArray(env, (jsize)decompressed_size);
+        if (entry == NULL) {
+            throw_region_failure(env);
+            return NULL;
+        }
+        
+        scratch_scope_t item_scope = scratch_begin();
+        int critical = use_critical_access(0, decompressed_size);
+        array_region_t dest_region = { entry, ARRAY_BYTE, 0, (jsize)decompressed_size, NULL, NULL };
+        if (region_acquire(env, &item_scope, critical, &dest_region, 0) != 0) {
+            scratch_end(&item_scope);
+            throw_region_failure(env);
+            return NULL;
+        }
+        
+        ZL_Report report = ZL_DCtx_decompress(decompressor->ctx, dest_region.data, decompressed_size, frame, frame_len);
+        
+        size_t written = ZL_isError(report) ? 0 : ZL_validResult(report);
+        region_release(env, &dest_region, critical, written);
+        scratch_end(&item_scope);
+        
+        if (ZL_isError(report)) {
+            throw_openzl_report_error(env, report);
+            return NULL;
+        }
+        if (written != decompressed_size) {
+            throw_openzl_exception(env, "[Error OpenZL JNI] Frame decompressed to an unexpected size");
+            return NULL;
+        }
+        (*env)->SetObjectArrayElement(env, result, i, entry);
+        (*env)->DeleteLocalRef(env, entry);
+    }
+    return result;
+}
+
+/**
+ * Decompresses a batch of frames stored back to back in src, frame i spanning
+ * [srcOffsets[i], srcOffsets[i + 1]), with one JNI transition and the instance's ZL_DCtx.
+ * Returns one new byte array per frame, or null with an exception thrown on failure.
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_net_openzl_OpenZLJNI_decompressBatch(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
+                                         jbyteArray src, jintArray src_offsets) {
+    if (decompressor_ptr == 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+        return NULL;
+    }
+    if (src == NULL || src_offsets == NULL) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Batch arrays cannot be null");
         return NULL;
     }
     
-    (*env)->SetByteArrayRegion(env, result, 0, compressed_size, (jbyte *)compressed_data);
-    free(compressed_data);
-    
+    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
+    scratch_scope_t scope = scratch_begin();
+    jobjectArray result = decompress_batch(env, &scope, decompressor, src, src_offsets);
+    scratch_end(&scope);
     return result;
 }
 
 /**
- * Compresses a Java long array using OpenZL's numeric compression pipeline.
- * Treats the data as an array of 64-bit signed integers (jlong) for optimized compression.
- * Returns a new byte array with the compressed data, or throws an exception on failure.
+ * Returns the worst-case compressed size for src_len input bytes. Sizes are 64-bit so
+ * multi-gigabyte inputs (MemorySegment and mapped-file paths) get an exact bound.
  */
-JNIEXPORT jbyteArray JNICALL
-Java_net_openzl_OpenZLJNI_compressNumericLongs(JNIEnv *env, jclass clazz, jlong compressor_ptr, jlongArray data) {
-    if (compressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI]  Invalid compressor");
+JNIEXPORT jlong JNICALL
+Java_net_openzl_OpenZLJNI_compressBound(JNIEnv *env, jclass clazz, jlong src_len) {
+    if (src_len < 0) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Source length cannot be negative");
+        return -1;
+    }
+    return (jlong)ZL_compressBound((size_t)src_len);
+}
+
+/**
+ * Returns the CPU the calling thread is running on, or -1 where the platform cannot
+ * tell. Used by per-CPU pools; the thread may migrate right after, so it is only a hint.
+ */
+JNIEXPORT jint JNICALL
+Java_net_openzl_OpenZLJNI_currentCpu(JNIEnv *env, jclass clazz) {
+#if defined(_WIN32)
+    return (jint)GetCurrentProcessorNumber();
+#elif defined(__linux__)
+    return (jint)sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+/**
+ * Analyzes OpenZL-compressed data and returns metadata about its contents.
+ * Returns a CompressionInfo object containing decompressed size, compressed size,
+ * data type (e.g., SERIAL, NUMERIC), and inferred compression graph.
+ * Throws an exception if the input is invalid or metadata cannot be extracted.
+ */
+
+JNIEXPORT jobject JNICALL
+Java_net_openzl_OpenZLJNI_getCompressionInfo(JNIEnv *env, jclass clazz, jbyteArray compressed_data) {
+    if (compressed_data == NULL) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Compressed data cannot be null");
         return NULL;
     }
     
-    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
-    
-    jsize array_len = (*env)->GetArrayLength(env, data);
-    jlong *array_data = (*env)->GetLongArrayElements(env, data, NULL);
-    
-    if (array_data == NULL) {
-        throw_out_of_memory(env);
+    jsize compressed_len = (*env)->GetArrayLength(env, compressed_data);
+    if (compressed_len <= 0) {
+        throw_openzl_exception(env, "[Error OpenZL JNI] Compressed data is empty");
         return NULL;
     }
     
-    size_t input_size = array_len * sizeof(jlong);
-    size_t max_compressed_size = ZL_compressBound(input_size);
-    
-    void *compressed_data = malloc(max_compressed_size);
-    if (compressed_data == NULL) {
-        (*env)->ReleaseLongArrayElements(env, data, array_data, JNI_ABORT);
-        throw_out_of_memory(env);
+    scratch_scope_t scope = scratch_begin();
+    int critical = use_critical_access(compressed_len, 0);
+    array_region_t region = { compressed_data, ARRAY_BYTE, 0, compressed_len, NULL, NULL };
+    if (region_acquire(env, &scope, critical, &region, 1) != 0) {
+        scratch_end(&scope);
+        throw_region_failure(env);
         return NULL;
     }
+    const void *compressed_bytes = region.data;
     
-    ZL_TypedRef* typed_ref = ZL_TypedRef_createNumeric(array_data, sizeof(jlong), array_len);
-    if (typed_ref == NULL) {
-        (*env)->ReleaseLongArrayElements(env, data, array_data, JNI_ABORT);
-        free(compressed_data);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference for numeric data");
+    ZL_Report compressed_size_result = ZL_getCompressedSize(compressed_bytes, compressed_len);
+    if (ZL_isError(compressed_size_result)) {
+        region_release(env, &region, critical, 0);
+        scratch_end(&scope);
+        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to get compressed size");
         return NULL;
     }
     
-    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
-        compressor->ctx,
-        compressed_data, max_compressed_size,
-        typed_ref
-    );
+    ZL_FrameInfo *frame_info = ZL_FrameInfo_create(compressed_bytes, compressed_len);
+    if (frame_info == NULL) {
+        region_release(env, &region, critical, 0);
+        scratch_end(&scope);
+        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create frame info");
+        return NULL;
+    }
     
-    ZL_TypedRef_free(typed_ref);
-    (*env)->ReleaseLongArrayElements(env, data, array_data, JNI_ABORT);
+    ZL_Report decompressed_size_result = ZL_FrameInfo_getDecompressedSize(frame_info, 0);
+    if (ZL_isError(decompressed_size_result)) {
+        ZL_FrameInfo_free(frame_info);
+        region_release(env, &region, critical, 0);
+        scratch_end(&scope);
+        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to get decompressed size");
+        return NULL;
+    }
     
-    if (ZL_isError(compress_report)) {
-        free(compressed_data);
-        throw_openzl_report_error(env, compress_report);
+    ZL_Report output_type_result = ZL_FrameInfo_getOutputType(frame_info, 0);
+    if (ZL_isError(output_type_result)) {
+        ZL_FrameInfo_free(frame_info);
+        region_release(env, &region, critical, 0);
+        scratch_end(&scope);
+        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to get output type");
         return NULL;
     }
     
-    size_t compressed_size = ZL_validResult(compress_report);
+    size_t compressed_size = ZL_validResult(compressed_size_result);
+    size_t decompressed_size = ZL_validResult(decompressed_size_result);
+    int output_type = (int)ZL_validResult(output_type_result);
     
-    jbyteArray result = (*env)->NewByteArray(env, compressed_size);
-    if (result == NULL) {
-        free(compressed_data);
-        throw_out_of_memory(env);
-        return NULL;
+    int data_type;
+    switch (output_type) {
+        case 0:
+            data_type = DATA_TYPE_SERIAL;
+            break;
+        case 1:
+            data_type = DATA_TYPE_STRUCT;
+            break;
+        case 2:
+            data_type = DATA_TYPE_NUMERIC;
+            break;
+        case 3:
+            data_type = DATA_TYPE_STRING;
+            break;
+        default:
+            data_type = DATA_TYPE_UNKNOWN;
+            break;
     }
     
-    (*env)->SetByteArrayRegion(env, result, 0, compressed_size, (jbyte *)compressed_data);
-    free(compressed_data);
+    ZL_FrameInfo_free(frame_info);
+    region_release(env, &region, critical, 0);
+    scratch_end(&scope);
+    
+    jobject compression_graph = data_type == DATA_TYPE_NUMERIC ? jni_cache.graph_numeric : jni_cache.graph_zstd;
     
-    return result;
+    jobject compression_info = (*env)->NewObject(env, jni_cache.compression_info, jni_cache.compression_info_init,
+                                                  (jlong)decompressed_size,
+                                                  (jlong)compressed_size,
+                                                  compression_graph,
+                                                  jni_cache.data_types[data_type]);
+    
+    return compression_info;
+}
+
+/*
+ * Native block-parallel compression. Blocks of one call are spread over a process-wide
+ * work-stealing pool (openzl_jni_pool.c), so a whole region is compressed or decompressed
+ * in a single JNI transition no matter how small the blocks are. Every worker lazily owns
+ * one compressor per graph and one ZL_DCtx, created on the worker itself and reused by all
+ * later calls. The container layout mirrors net.openzl.OpenZLFrameFormat.
+ */
+#define CONTAINER_MAGIC 0x424C5A4Fu
+#define CONTAINER_INDEX_MAGIC 0x584C5A4Fu
+#define CONTAINER_VERSION 1u
+#define CONTAINER_FLAG_INDEXED 1u
+#define CONTAINER_HEADER_SIZE ((size_t)16)
+#define CONTAINER_BLOCK_HEADER_SIZE ((size_t)8)
+#define CONTAINER_END_MARKER_SIZE ((size_t)4)
+#define CONTAINER_INDEX_ENTRY_SIZE ((size_t)16)
+#define CONTAINER_TRAILER_SIZE ((size_t)16)
+#define CONTAINER_MIN_BLOCK_SIZE (4 * 1024)
+#define CONTAINER_MAX_BLOCK_SIZE (1 << 30)
+
+typedef struct {
+    openzl_pool_t *pool;
+    int size;
+    openzl_compressor_t *compressors;
+    ZL_DCtx **dctxs;
+} parallel_runtime_t;
+
+static _Atomic(parallel_runtime_t *) parallel_runtime;
+
+static void parallel_runtime_destroy(parallel_runtime_t *runtime) {
+    if (runtime == NULL) {
+        return;
+    }
+    openzl_pool_destroy(runtime->pool);
+    if (runtime->compressors != NULL) {
+        for (size_t i = 0; i < (size_t)runtime->size * GRAPH_SLOT_COUNT; i++) {
+            compressor_release(&runtime->compressors[i]);
+        }
+    }
+    if (runtime->dctxs != NULL) {
+        for (int i = 0; i < runtime->size; i++) {
+            if (runtime->dctxs[i] != NULL) {
+                ZL_DCtx_free(runtime->dctxs[i]);
+            }
+        }
+    }
+    free(runtime->compressors);
+    free(runtime->dctxs);
+    free(runtime);
 }
 
 /**
- * Compresses a Java float array by treating its binary representation as numeric data.
- * Returns a new byte array with compressed data, or throws an exception on failure.
- * Optimized for 32-bit floats using OpenZL's numeric compression pipeline.
+ * Returns the shared runtime, starting one worker per online processor on first use.
+ * Racing first calls each build one and all but the winner of the CAS discard theirs.
  */
-JNIEXPORT jbyteArray JNICALL
-Java_net_openzl_OpenZLJNI_compressNumericFloats(JNIEnv *env, jclass clazz, jlong compressor_ptr, jfloatArray data) {
-    if (compressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
-        return NULL;
+static parallel_runtime_t *parallel_runtime_get(void) {
+    parallel_runtime_t *runtime = atomic_load_explicit(&parallel_runtime, memory_order_acquire);
+    if (runtime != NULL) {
+        return runtime;
     }
     
-    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
-    
-    jsize array_len = (*env)->GetArrayLength(env, data);
-    jfloat *array_data = (*env)->GetFloatArrayElements(env, data, NULL);
-    
-    if (array_data == NULL) {
-        throw_out_of_memory(env);
+    runtime = calloc(1, sizeof(parallel_runtime_t));
+    if (runtime == NULL) {
+        return NULL;
+    }
+    runtime->size = openzl_hardware_threads();
+    runtime->compressors = calloc((size_t)runtime->size * GRAPH_SLOT_COUNT, sizeof(openzl_compressor_t));
+    runtime->dctxs = calloc((size_t)runtime->size, sizeof(ZL_DCtx *));
+    if (runtime->compressors == NULL || runtime->dctxs == NULL) {
+        parallel_runtime_destroy(runtime);
+        return NULL;
+    }
+    runtime->pool = openzl_pool_create(runtime->size);
+    if (runtime->pool == NULL) {
+        parallel_runtime_destroy(runtime);
         return NULL;
     }
     
-    size_t input_size = array_len * sizeof(jfloat);
-    size_t max_compressed_size = ZL_compressBound(input_size);
+    parallel_runtime_t *expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&parallel_runtime, &expected, runtime,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        parallel_runtime_destroy(runtime);
+        return expected;
+    }
+    return runtime;
+}
+
+/**
+ * First error raised by any block of a parallel job. Only the thread that wins the CAS on
+ * failed writes message / report; the caller reads them after openzl_pool_run() returns.
+ */
+typedef struct {
+    atomic_int failed;
+    const char *message;
+    ZL_Report report;
+} parallel_error_t;
+
+static void parallel_fail(parallel_error_t *error, const char *message, const ZL_Report *report) {
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&error->failed, &expected, 1)) {
+        error->message = message;
+        if (report != NULL) {
+            error->report = *report;
+        }
+    }
+}
+
+static void parallel_throw(JNIEnv *env, parallel_error_t *error) {
+    if (error->message != NULL) {
+        throw_openzl_exception(env, error->message);
+    } else {
+        throw_openzl_report_error(env, error->report);
+    }
+}
+
+static void store_le32(uint8_t *dest, uint32_t value) {
+    dest[0] = (uint8_t)value;
+    dest[1] = (uint8_t)(value >> 8);
+    dest[2] = (uint8_t)(value >> 16);
+    dest[3] = (uint8_t)(value >> 24);
+}
+
+static void store_le64(uint8_t *dest, uint64_t value) {
+    store_le32(dest, (uint32_t)value);
+    store_le32(dest + 4, (uint32_t)(value >> 32));
+}
+
+typedef struct {
+    parallel_runtime_t *runtime;
+    jint graph_slot;
+    const uint8_t *src;
+    size_t src_size;
+    size_t block_size;
+    uint8_t *dest;
+    uint8_t *slots;
+    size_t slot_size;
+    uint32_t *compressed_sizes;
+    parallel_error_t error;
+} parallel_compress_job_t;
+
+/**
+ * Compresses block task into its fixed slot of slots; slots are sized for the worst case
+ * so blocks never wait on each other and are compacted or written out afterwards.
+ */
+static void parallel_compress_block(void *arg, size_t task, int worker) {
+    parallel_compress_job_t *job = arg;
+    if (atomic_load_explicit(&job->error.failed, memory_order_relaxed)) {
+        return;
+    }
     
-    void *compressed_data = malloc(max_compressed_size);
-    if (compressed_data == NULL) {
-        (*env)->ReleaseFloatArrayElements(env, data, array_data, JNI_ABORT);
+    openzl_compressor_t *compressor = &job->runtime->compressors[(size_t)worker * GRAPH_SLOT_COUNT + job->graph_slot];
+    if (compressor->ctx == NULL) {
+        const char *message;
+        ZL_Report report;
+        if (compressor_init(compressor, job->graph_slot, &message, &report) != 0) {
+            parallel_fail(&job->error, message, &report);
+            return;
+        }
+    }
+    
+    size_t offset = task * job->block_size;
+    size_t length = job->src_size - offset < job->block_size ? job->src_size - offset : job->block_size;
+    uint8_t *frame = job->slots + task * job->slot_size + CONTAINER_BLOCK_HEADER_SIZE;
+    ZL_Report report = ZL_CCtx_compress(compressor->ctx, frame, job->slot_size - CONTAINER_BLOCK_HEADER_SIZE,
+                                        job->src + offset, length);
+    if (ZL_isError(report)) {
+        parallel_fail(&job->error, NULL, &report);
+        return;
+    }
+    job->compressed_sizes[task] = (uint32_t)ZL_validResult(report);
+}
+
+static size_t parallel_block_count(size_t src_size, size_t block_size) {
+    return src_size / block_size + (src_size % block_size != 0);
+}
+
+/**
+ * Destination capacity compressParallel needs: every block in a worst-case slot, followed
+ * by the end marker, index and trailer. Returns 0 on size_t overflow.
+ */
+static size_t parallel_compress_capacity(size_t src_size, size_t block_size, size_t *slot_size) {
+    size_t count = parallel_block_count(src_size, block_size);
+    *slot_size = CONTAINER_BLOCK_HEADER_SIZE + ZL_compressBound(block_size);
+    size_t per_block = *slot_size + CONTAINER_INDEX_ENTRY_SIZE;
+    if (count != 0 && per_block > (SIZE_MAX - 64) / count) {
+        return 0;
+    }
+    return CONTAINER_HEADER_SIZE + count * per_block + CONTAINER_END_MARKER_SIZE + CONTAINER_TRAILER_SIZE;
+}
+
+/**
+ * Writes the end marker, index and trailer of a container whose last block ends at
+ * container offset end into dest. Blocks are full-sized except the last, which holds the
+ * rest of src_size. Returns the number of bytes written.
+ */
+static size_t container_footer(uint8_t *dest, size_t end, const uint32_t *compressed_sizes, size_t count,
+                               size_t src_size, size_t block_size) {
+    store_le32(dest, 0);
+    size_t entry = CONTAINER_END_MARKER_SIZE;
+    size_t frame_offset = CONTAINER_HEADER_SIZE + CONTAINER_BLOCK_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        size_t raw = i == count - 1 ? src_size - i * block_size : block_size;
+        store_le64(dest + entry, frame_offset);
+        store_le32(dest + entry + 8, compressed_sizes[i]);
+        store_le32(dest + entry + 12, (uint32_t)raw);
+        frame_offset += compressed_sizes[i] + CONTAINER_BLOCK_HEADER_SIZE;
+        entry += CONTAINER_INDEX_ENTRY_SIZE;
+    }
+    store_le64(dest + entry, end + CONTAINER_END_MARKER_SIZE);
+    store_le32(dest + entry + 8, (uint32_t)count);
+    store_le32(dest + entry + 12, CONTAINER_INDEX_MAGIC);
+    return entry + CONTAINER_TRAILER_SIZE;
+}
+
+static size_t container_footer_size(size_t count) {
+    return CONTAINER_END_MARKER_SIZE + count * CONTAINER_INDEX_ENTRY_SIZE + CONTAINER_TRAILER_SIZE;
+}
+
+static void container_header(uint8_t *dest, size_t block_size) {
+    store_le32(dest, CONTAINER_MAGIC);
+    store_le32(dest + 4, CONTAINER_VERSION | (CONTAINER_FLAG_INDEXED << 8));
+    store_le32(dest + 8, (uint32_t)block_size);
+    store_le32(dest + 12, 0);
+}
+
+/**
+ * Slides the count compressed blocks of a job's slots down into one contiguous run, each
+ * behind its block header. Returns the length of the run.
+ */
+static size_t pack_blocks(const parallel_compress_job_t *job, size_t count) {
+    uint8_t *slots = job->slots;
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t raw = i == count - 1 ? job->src_size - i * job->block_size : job->block_size;
+        uint8_t *frame = slots + i * job->slot_size + CONTAINER_BLOCK_HEADER_SIZE;
+        if (frame != slots + pos + CONTAINER_BLOCK_HEADER_SIZE) {
+            memmove(slots + pos + CONTAINER_BLOCK_HEADER_SIZE, frame, job->compressed_sizes[i]);
+        }
+        store_le32(slots + pos, job->compressed_sizes[i]);
+        store_le32(slots + pos + 4, (uint32_t)raw);
+        pos += CONTAINER_BLOCK_HEADER_SIZE + job->compressed_sizes[i];
+    }
+    return pos;
+}
+
+/**
+ * Packs the slotted blocks into a contiguous container and adds the header, end marker,
+ * index and trailer around them. Returns the container size.
+ */
+static size_t parallel_assemble(parallel_compress_job_t *job, size_t count) {
+    uint8_t *dest = job->dest;
+    container_header(dest, job->block_size);
+    size_t pos = CONTAINER_HEADER_SIZE + pack_blocks(job, count);
+    return pos + container_footer(dest + pos, pos, job->compressed_sizes, count, job->src_size, job->block_size);
+}
+
+static jlong compress_parallel(JNIEnv *env, scratch_scope_t *scope, jint graph_id,
+                               const uint8_t *src, size_t src_size, uint8_t *dest, size_t dest_capacity,
+                               size_t block_size, jint threads) {
+    size_t slot_size;
+    size_t required = parallel_compress_capacity(src_size, block_size, &slot_size);
+    if (required == 0 || dest_capacity < required) {
+        throw_exception(env, jni_cache.illegal_argument_exception,
+                        "[Error OpenZL JNI] Destination is smaller than the parallel compression bound");
+        return -1;
+    }
+    
+    parallel_runtime_t *runtime = parallel_runtime_get();
+    size_t count = parallel_block_count(src_size, block_size);
+    uint32_t *compressed_sizes = scratch_alloc(scope, count * sizeof(uint32_t));
+    if (runtime == NULL || (count != 0 && compressed_sizes == NULL)) {
         throw_out_of_memory(env);
-        return NULL;
+        return -1;
     }
     
-    ZL_TypedRef* typed_ref = ZL_TypedRef_createNumeric(array_data, sizeof(jfloat), array_len);
-    if (typed_ref == NULL) {
-        (*env)->ReleaseFloatArrayElements(env, data, array_data, JNI_ABORT);
-        free(compressed_data);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference for numeric data");
-        return NULL;
+    parallel_compress_job_t job;
+    job.runtime = runtime;
+    job.graph_slot = graph_slot(graph_id);
+    job.src = src;
+    job.src_size = src_size;
+    job.block_size = block_size;
+    job.dest = dest;
+    job.slots = dest + CONTAINER_HEADER_SIZE;
+    job.slot_size = slot_size;
+    job.compressed_sizes = compressed_sizes;
+    atomic_init(&job.error.failed, 0);
+    job.error.message = NULL;
+    
+    openzl_pool_run(runtime->pool, count, threads, parallel_compress_block, &job);
+    if (atomic_load(&job.error.failed)) {
+        parallel_throw(env, &job.error);
+        return -1;
+    }
+    return (jlong)parallel_assemble(&job, count);
+}
+
+/**
+ * Compresses srcSize bytes at srcAddress into an indexed block container at destAddress,
+ * fanning the blocks out over the native worker pool inside this one call. threads caps
+ * the number of workers (<= 0 uses all of them). destCapacity must be at least the bound
+ * computed by OpenZLParallel.maxCompressedLength. Returns the container size, or -1 if an
+ * error occurs (exception thrown).
+ */
+JNIEXPORT jlong JNICALL
+Java_net_openzl_OpenZLJNI_compressParallel(JNIEnv *env, jclass clazz, jint graph_id,
+                                          jlong src_address, jlong src_size,
+                                          jlong dest_address, jlong dest_capacity,
+                                          jint block_size, jint threads) {
+    if (src_size < 0 || dest_capacity < 0 || (src_size > 0 && src_address == 0) || dest_address == 0) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Invalid memory region");
+        return -1;
+    }
+    if (block_size < CONTAINER_MIN_BLOCK_SIZE || block_size > CONTAINER_MAX_BLOCK_SIZE) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Invalid block size");
+        return -1;
     }
     
-    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
-        compressor->ctx,
-        compressed_data, max_compressed_size,
-        typed_ref
-    );
+    scratch_scope_t scope = scratch_begin();
+    jlong result = compress_parallel(env, &scope, graph_id,
+                                     (const uint8_t *)(uintptr_t)src_address, (size_t)src_size,
+                                     (uint8_t *)(uintptr_t)dest_address, (size_t)dest_capacity,
+                                     (size_t)block_size, threads);
+    scratch_end(&scope);
+    return result;
+}
+
+typedef struct {
+    parallel_runtime_t *runtime;
+    const uint8_t *src;
+    uint8_t *dest;
+    const jlong *frame_offsets;
+    const jint *compressed_sizes;
+    const jlong *raw_offsets;
+    const jint *raw_sizes;
+    parallel_error_t error;
+} parallel_decompress_job_t;
+
+static void parallel_decompress_block(void *arg, size_t task, int worker) {
+    parallel_decompress_job_t *job = arg;
+    if (atomic_load_explicit(&job->error.failed, memory_order_relaxed)) {
+        return;
+    }
     
-    ZL_TypedRef_free(typed_ref);
-    (*env)->ReleaseFloatArrayElements(env, data, array_data, JNI_ABORT);
+    ZL_DCtx **dctx = &job->runtime->dctxs[worker];
+    if (*dctx == NULL) {
+        *dctx = ZL_DCtx_create();
+        if (*dctx == NULL) {
+            parallel_fail(&job->error, "Failed to create decompression context", NULL);
+            return;
+        }
+    }
     
-    if (ZL_isError(compress_report)) {
-        free(compressed_data);
-        throw_openzl_report_error(env, compress_report);
-        return NULL;
+    size_t raw_size = (size_t)job->raw_sizes[task];
+    ZL_Report report = ZL_DCtx_decompress(*dctx, job->dest + job->raw_offsets[task], raw_size,
+                                          job->src + job->frame_offsets[task], (size_t)job->compressed_sizes[task]);
+    if (ZL_isError(report)) {
+        parallel_fail(&job->error, NULL, &report);
+    } else if (ZL_validResult(report) != raw_size) {
+        parallel_fail(&job->error, "[Error OpenZL JNI] Block decompressed to an unexpected size", NULL);
+    }
+}
+
+static jlong decompress_parallel(JNIEnv *env, scratch_scope_t *scope,
+                                 const uint8_t *src, size_t src_size, uint8_t *dest, size_t dest_capacity,
+                                 jlongArray frame_offsets, jintArray compressed_sizes,
+                                 jlongArray raw_offsets, jintArray raw_sizes, jint threads) {
+    jsize count = (*env)->GetArrayLength(env, frame_offsets);
+    if ((*env)->GetArrayLength(env, compressed_sizes) != count || (*env)->GetArrayLength(env, raw_offsets) != count
+            || (*env)->GetArrayLength(env, raw_sizes) != count) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Block table arrays differ in length");
+        return -1;
     }
     
-    size_t compressed_size = ZL_validResult(compress_report);
+    array_region_t frames = { frame_offsets, ARRAY_LONG, 0, count, NULL, NULL };
+    array_region_t sizes = { compressed_sizes, ARRAY_INT, 0, count, NULL, NULL };
+    array_region_t raws = { raw_offsets, ARRAY_LONG, 0, count, NULL, NULL };
+    array_region_t raw_lengths = { raw_sizes, ARRAY_INT, 0, count, NULL, NULL };
+    if (region_acquire(env, scope, 0, &frames, 1) != 0 || region_acquire(env, scope, 0, &sizes, 1) != 0
+            || region_acquire(env, scope, 0, &raws, 1) != 0 || region_acquire(env, scope, 0, &raw_lengths, 1) != 0) {
+        throw_region_failure(env);
+        return -1;
+    }
     
-    jbyteArray result = (*env)->NewByteArray(env, compressed_size);
-    if (result == NULL) {
-        free(compressed_data);
+    parallel_decompress_job_t job;
+    job.src = src;
+    job.dest = dest;
+    job.frame_offsets = frames.data;
+    job.compressed_sizes = sizes.data;
+    job.raw_offsets = raws.data;
+    job.raw_sizes = raw_lengths.data;
+    
+    size_t total = 0;
+    for (jsize i = 0; i < count; i++) {
+        if (job.frame_offsets[i] < 0 || job.compressed_sizes[i] < 0 || job.raw_offsets[i] < 0 || job.raw_sizes[i] < 0
+                || (size_t)job.frame_offsets[i] > src_size
+                || (size_t)job.compressed_sizes[i] > src_size - (size_t)job.frame_offsets[i]
+                || (size_t)job.raw_offsets[i] > dest_capacity
+                || (size_t)job.raw_sizes[i] > dest_capacity - (size_t)job.raw_offsets[i]) {
+            throw_exception(env, jni_cache.index_out_of_bounds_exception, "[Error OpenZL JNI] Block out of bounds");
+            return -1;
+        }
+        total += (size_t)job.raw_sizes[i];
+    }
+    
+    job.runtime = parallel_runtime_get();
+    if (job.runtime == NULL) {
         throw_out_of_memory(env);
-        return NULL;
+        return -1;
     }
+    atomic_init(&job.error.failed, 0);
+    job.error.message = NULL;
     
-    (*env)->SetByteArrayRegion(env, result, 0, compressed_size, (jbyte *)compressed_data);
-    free(compressed_data);
-    
-    return result;
+    openzl_pool_run(job.runtime->pool, (size_t)count, threads, parallel_decompress_block, &job);
+    if (atomic_load(&job.error.failed)) {
+        parallel_throw(env, &job.error);
+        return -1;
+    }
+    return (jlong)total;
 }
 
 /**
- * Compresses a Java double array using OpenZL's numeric compression pipeline.
- * Treats the data as an array of 64-bit floating-point values for optimized compression.
- * Returns a new byte array with the compressed data, or throws an exception on failure.
+ * Decodes the blocks of a container at srcAddress into their final offsets of destAddress,
+ * one pool task per block. The block table is parsed on the Java side
+ * (OpenZLFrameFormat.readBlockTable) and bounds-checked again here. Returns the number of
+ * bytes written, or -1 if an error occurs (exception thrown).
  */
-JNIEXPORT jbyteArray JNICALL
-Java_net_openzl_OpenZLJNI_compressNumericDoubles(JNIEnv *env, jclass clazz, jlong compressor_ptr, jdoubleArray data) {
-    if (compressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid compressor");
-        return NULL;
+JNIEXPORT jlong JNICALL
+Java_net_openzl_OpenZLJNI_decompressParallel(JNIEnv *env, jclass clazz,
+                                            jlong src_address, jlong src_size,
+                                            jlong dest_address, jlong dest_capacity,
+                                            jlongArray frame_offsets, jintArray compressed_sizes,
+                                            jlongArray raw_offsets, jintArray raw_sizes, jint threads) {
+    if (src_size < 0 || dest_capacity < 0 || (src_size > 0 && src_address == 0)
+            || (dest_capacity > 0 && dest_address == 0)) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Invalid memory region");
+        return -1;
     }
-    
-    openzl_compressor_t *compressor = (openzl_compressor_t *)(uintptr_t)compressor_ptr;
-    
-    jsize array_len = (*env)->GetArrayLength(env, data);
-    jdouble *array_data = (*env)->GetDoubleArrayElements(env, data, NULL);
-    
-    if (array_data == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
+    if (frame_offsets == NULL || compressed_sizes == NULL || raw_offsets == NULL || raw_sizes == NULL) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Block table cannot be null");
+        return -1;
     }
     
-    size_t input_size = array_len * sizeof(jdouble);
-    size_t max_compressed_size = ZL_compressBound(input_size);
+    scratch_scope_t scope = scratch_begin();
+    jlong result = decompress_parallel(env, &scope,
+                                       (const uint8_t *)(uintptr_t)src_address, (size_t)src_size,
+                                       (uint8_t *)(uintptr_t)dest_address, (size_t)dest_capacity,
+                                       frame_offsets, compressed_sizes, raw_offsets, raw_sizes, threads);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Walks a run of concatenated frames, sizing each one with ZL_getCompressedSize, and stores
+ * an (offset, compressed size, decompressed size) triple per frame in frames when it is
+ * non-NULL. Only frame headers are read, so both passes are cheap next to decoding.
+ * Returns the frame count, or -1 with error set.
+ */
+static jlong scan_frames(const uint8_t *src, size_t src_size, jlong *frames, parallel_error_t *error) {
+    size_t pos = 0;
+    jlong count = 0;
+    while (pos < src_size) {
+        ZL_Report compressed = ZL_getCompressedSize(src + pos, src_size - pos);
+        if (ZL_isError(compressed)) {
+            parallel_fail(error, NULL, &compressed);
+            return -1;
+        }
+        size_t frame_size = ZL_validResult(compressed);
+        if (frame_size == 0 || frame_size > src_size - pos) {
+            parallel_fail(error, "[Error OpenZL JNI] Frame extends past the end of the input", NULL);
+            return -1;
+        }
+        ZL_Report raw = ZL_getDecompressedSize(src + pos, frame_size);
+        if (ZL_isError(raw)) {
+            parallel_fail(error, NULL, &raw);
+            return -1;
+        }
+        if (frames != NULL) {
+            frames[3 * count] = (jlong)pos;
+            frames[3 * count + 1] = (jlong)frame_size;
+            frames[3 * count + 2] = (jlong)ZL_validResult(raw);
+        }
+        count++;
+        pos += frame_size;
+    }
+    return count;
+}
+
+/**
+ * Counts the frames of src, then records them into a scratch table of 3 * *count longs.
+ * Returns NULL with error set on failure. Makes no JNI calls, so src may be a critical
+ * region.
+ */
+static jlong *scan_frame_table(scratch_scope_t *scope, const uint8_t *src, size_t src_size,
+                               jlong *count, parallel_error_t *error) {
+    atomic_init(&error->failed, 0);
+    error->message = NULL;
     
-    void *compressed_data = malloc(max_compressed_size);
-    if (compressed_data == NULL) {
-        (*env)->ReleaseDoubleArrayElements(env, data, array_data, JNI_ABORT);
-        throw_out_of_memory(env);
+    *count = scan_frames(src, src_size, NULL, error);
+    if (*count < 0) {
         return NULL;
     }
-    
-    ZL_TypedRef* typed_ref = ZL_TypedRef_createNumeric(array_data, sizeof(jdouble), array_len);
-    if (typed_ref == NULL) {
-        (*env)->ReleaseDoubleArrayElements(env, data, array_data, JNI_ABORT);
-        free(compressed_data);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create typed reference for numeric data");
+    if ((size_t)*count > MAX_JAVA_ARRAY_LENGTH / 3) {
+        parallel_fail(error, "[Error OpenZL JNI] Too many frames for one frame table", NULL);
         return NULL;
     }
-    
-    ZL_Report compress_report = ZL_CCtx_compressTypedRef(
-        compressor->ctx,
-        compressed_data, max_compressed_size,
-        typed_ref
-    );
-    
-    ZL_TypedRef_free(typed_ref);
-    (*env)->ReleaseDoubleArrayElements(env, data, array_data, JNI_ABORT);
-    
-    if (ZL_isError(compress_report)) {
-        free(compressed_data);
-        throw_openzl_report_error(env, compress_report);
+    jlong *frames = scratch_alloc(scope, ((size_t)*count * 3 + 1) * sizeof(jlong));
+    if (frames == NULL) {
+        parallel_fail(error, "[Error OpenZL JNI] Failed to allocate the frame table", NULL);
         return NULL;
     }
-    
-    size_t compressed_size = ZL_validResult(compress_report);
-    
-    jbyteArray result = (*env)->NewByteArray(env, compressed_size);
-    if (result == NULL) {
-        free(compressed_data);
-        throw_out_of_memory(env);
+    scan_frames(src, src_size, frames, error);
+    return frames;
+}
+
+static jlongArray frame_table_array(JNIEnv *env, const jlong *frames, jlong count, parallel_error_t *error) {
+    if (frames == NULL) {
+        parallel_throw(env, error);
         return NULL;
     }
-    
-    (*env)->SetByteArrayRegion(env, result, 0, compressed_size, (jbyte *)compressed_data);
-    free(compressed_data);
-    
-    return result;
+    return (jlongArray)new_array_from(env, ARRAY_LONG, (jsize)(count * 3), frames);
 }
 
 /**
- * Decompresses serial (byte array) data compressed with OpenZL.
- * Returns a new Java byte array containing the original uncompressed data.
- * Throws an exception on failure (e.g., corrupted input or invalid format).
+ * Locates every frame of a run of concatenated OpenZL frames at srcAddress. Returns
+ * (offset, compressed size, decompressed size) triples, which OpenZLParallel turns into a
+ * block table for decompressParallel, or NULL if an error occurs (exception thrown).
  */
-JNIEXPORT jbyteArray JNICALL
-Java_net_openzl_OpenZLJNI_decompressSerial(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
-                                          jbyteArray src, jint src_off, jint src_len) {
-    if (decompressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
-        return NULL;
-    }
-    
-    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
-    
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    if (src_data == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
-    }
-    
-    ZL_Report size_report = ZL_getDecompressedSize(src_data + src_off, src_len);
-    if (ZL_isError(size_report)) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_openzl_report_error(env, size_report);
+JNIEXPORT jlongArray JNICALL
+Java_net_openzl_OpenZLJNI_scanFrames(JNIEnv *env, jclass clazz, jlong src_address, jlong src_size) {
+    if (src_size < 0 || (src_size > 0 && src_address == 0)) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Invalid memory region");
         return NULL;
     }
     
-    size_t decompressed_size = ZL_validResult(size_report);
-    
-    void *decompressed_data = malloc(decompressed_size);
-    if (decompressed_data == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_out_of_memory(env);
+    scratch_scope_t scope = scratch_begin();
+    parallel_error_t error;
+    jlong count;
+    jlong *frames = scan_frame_table(&scope, (const uint8_t *)(uintptr_t)src_address, (size_t)src_size,
+                                     &count, &error);
+    jlongArray result = frame_table_array(env, frames, count, &error);
+    scratch_end(&scope);
+    return result;
+}
+
+/**
+ * Same as scanFrames for the frames in src[srcOff, srcOff + srcLen). The array is held
+ * critically for the scan, which only touches frame headers.
+ */
+JNIEXPORT jlongArray JNICALL
+Java_net_openzl_OpenZLJNI_scanFramesArray(JNIEnv *env, jclass clazz, jbyteArray src, jint src_off, jint src_len) {
+    if (src == NULL) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Source array cannot be null");
         return NULL;
     }
-    
-    ZL_Report decompress_report = ZL_decompress(
-        decompressed_data, decompressed_size,
-        src_data + src_off, src_len
-    );
-    
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-    
-    if (ZL_isError(decompress_report)) {
-        free(decompressed_data);
-        throw_openzl_report_error(env, decompress_report);
+    if (src_off < 0 || src_len < 0 || src_off > (*env)->GetArrayLength(env, src) - src_len) {
+        throw_exception(env, jni_cache.index_out_of_bounds_exception, "[Error OpenZL JNI] Invalid offset or length");
         return NULL;
     }
     
-    size_t result_size = ZL_validResult(decompress_report);
-    
-    jbyteArray result = (*env)->NewByteArray(env, result_size);
-    if (result == NULL) {
-        free(decompressed_data);
-        throw_out_of_memory(env);
+    scratch_scope_t scope = scratch_begin();
+    array_region_t region = { src, ARRAY_BYTE, src_off, src_len, NULL, NULL };
+    if (region_acquire(env, &scope, 1, &region, 1) != 0) {
+        scratch_end(&scope);
+        throw_region_failure(env);
         return NULL;
     }
+    parallel_error_t error;
+    jlong count;
+    jlong *frames = scan_frame_table(&scope, region.data, (size_t)src_len, &count, &error);
+    region_release(env, &region, 1, 0);
     
-    (*env)->SetByteArrayRegion(env, result, 0, result_size, (jbyte *)decompressed_data);
-    free(decompressed_data);
-    
+    jlongArray result = frame_table_array(env, frames, count, &error);
+    scratch_end(&scope);
     return result;
 }
 
+#if !defined(_WIN32)
+
+static uint32_t load_le32(const uint8_t *src) {
+    return (uint32_t)src[0] | (uint32_t)src[1] << 8 | (uint32_t)src[2] << 16 | (uint32_t)src[3] << 24;
+}
+
+static uint64_t load_le64(const uint8_t *src) {
+    return (uint64_t)load_le32(src) | (uint64_t)load_le32(src + 4) << 32;
+}
+
 /**
- * Decompresses OpenZL-compressed byte data directly into a pre-allocated destination buffer.
- * Returns the actual decompressed size on success, or -1 if an error occurs (exception thrown).
- * The destination buffer must be large enough to hold the full decompressed output.
+ * Block table of a container read in native code; mirrors OpenZLFrameFormat.BlockTable.
  */
-JNIEXPORT jint JNICALL
-Java_net_openzl_OpenZLJNI_decompressSerialToBuffer(JNIEnv *env, jclass clazz, jlong decompressor_ptr,
-                                                  jbyteArray src, jint src_off, jint src_len,
-                                                  jbyteArray dest, jint dest_off, jint max_dest_len) {
-    if (decompressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
+typedef struct {
+    size_t count;
+    size_t block_size;
+    jlong *frame_offsets;
+    jint *compressed_sizes;
+    jint *raw_sizes;
+    size_t raw_size;
+} container_table_t;
+
+static const char *container_entry(container_table_t *table, size_t i, uint64_t frame_offset,
+                                   uint32_t compressed_size, uint32_t raw_size, size_t limit) {
+    if (frame_offset < CONTAINER_HEADER_SIZE + CONTAINER_BLOCK_HEADER_SIZE || frame_offset > limit
+            || compressed_size == 0 || compressed_size > INT32_MAX || compressed_size > limit - frame_offset
+            || raw_size > table->block_size) {
+        return "[Error OpenZL JNI] Corrupt OpenZL block container: block out of bounds";
+    }
+    table->frame_offsets[i] = (jlong)frame_offset;
+    table->compressed_sizes[i] = (jint)compressed_size;
+    table->raw_sizes[i] = (jint)raw_size;
+    table->raw_size += raw_size;
+    return NULL;
+}
+
+/**
+ * Reads the block table of the container in src: from the index when the container is
+ * flagged as indexed, otherwise by walking the block headers up to the end marker. A
+ * flagged container without a valid trailer is corrupt, as in
+ * OpenZLFrameFormat.readBlockTable, which applies the same checks. Raw sizes are checked
+ * against the block size so callers can decode into block-sized buffers. Returns NULL, or
+ * an error message.
+ */
+static const char *container_table_read(scratch_scope_t *scope, const uint8_t *src, size_t src_size,
+                                        container_table_t *table) {
+    if (src_size < CONTAINER_HEADER_SIZE + CONTAINER_END_MARKER_SIZE || load_le32(src) != CONTAINER_MAGIC) {
+        return "[Error OpenZL JNI] Not an OpenZL block container";
+    }
+    uint32_t flags = load_le32(src + 4);
+    if ((flags & 0xFF) != CONTAINER_VERSION) {
+        return "[Error OpenZL JNI] Unsupported block container version";
+    }
+    uint32_t block_size = load_le32(src + 8);
+    if (block_size < CONTAINER_MIN_BLOCK_SIZE || block_size > CONTAINER_MAX_BLOCK_SIZE) {
+        return "[Error OpenZL JNI] Corrupt OpenZL block container: invalid block size";
+    }
+    table->block_size = block_size;
+    table->raw_size = 0;
+    
+    size_t index_offset = 0;
+    size_t count = 0;
+    int indexed = (flags >> 8 & CONTAINER_FLAG_INDEXED) != 0;
+    if (indexed) {
+        if (src_size < CONTAINER_HEADER_SIZE + CONTAINER_END_MARKER_SIZE + CONTAINER_TRAILER_SIZE) {
+            return "[Error OpenZL JNI] Corrupt OpenZL block container: truncated trailer";
+        }
+        const uint8_t *trailer = src + src_size - CONTAINER_TRAILER_SIZE;
+        uint64_t offset = load_le64(trailer);
+        count = load_le32(trailer + 8);
+        size_t limit = src_size - CONTAINER_TRAILER_SIZE;
+        if (load_le32(trailer + 12) != CONTAINER_INDEX_MAGIC
+                || offset < CONTAINER_HEADER_SIZE + CONTAINER_END_MARKER_SIZE || offset > limit
+                || count != (limit - offset) / CONTAINER_INDEX_ENTRY_SIZE
+                || (limit - offset) % CONTAINER_INDEX_ENTRY_SIZE != 0) {
+            return "[Error OpenZL JNI] Corrupt OpenZL block container: invalid index";
+        }
+        index_offset = (size_t)offset;
+    } else {
+        size_t pos = CONTAINER_HEADER_SIZE;
+        while (1) {
+            if (src_size - pos < CONTAINER_END_MARKER_SIZE) {
+                return "[Error OpenZL JNI] Truncated OpenZL block container";
+            }
+            uint32_t compressed_size = load_le32(src + pos);
+            if (compressed_size == 0) {
+                break;
+            }
+            if (src_size - pos < CONTAINER_BLOCK_HEADER_SIZE
+                    || compressed_size > src_size - pos - CONTAINER_BLOCK_HEADER_SIZE) {
+                return "[Error OpenZL JNI] Truncated OpenZL block container";
+            }
+            pos += CONTAINER_BLOCK_HEADER_SIZE + compressed_size;
+            count++;
+        }
+    }
+    if (count > MAX_JAVA_ARRAY_LENGTH) {
+        return "[Error OpenZL JNI] Too many blocks in one container";
+    }
+    
+    table->count = count;
+    table->frame_offsets = scratch_alloc(scope, (count + 1) * sizeof(jlong));
+    table->compressed_sizes = scratch_alloc(scope, (count + 1) * sizeof(jint));
+    table->raw_sizes = scratch_alloc(scope, (count + 1) * sizeof(jint));
+    if (table->frame_offsets == NULL || table->compressed_sizes == NULL || table->raw_sizes == NULL) {
+        return "[Error OpenZL JNI] Failed to allocate the block table";
+    }
+    
+    size_t pos = CONTAINER_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        const char *message;
+        if (indexed) {
+            const uint8_t *entry = src + index_offset + i * CONTAINER_INDEX_ENTRY_SIZE;
+            message = container_entry(table, i, load_le64(entry), load_le32(entry + 8), load_le32(entry + 12),
+                                      index_offset - CONTAINER_END_MARKER_SIZE);
+        } else {
+            message = container_entry(table, i, pos + CONTAINER_BLOCK_HEADER_SIZE, load_le32(src + pos),
+                                      load_le32(src + pos + 4), src_size);
+            pos += CONTAINER_BLOCK_HEADER_SIZE + load_le32(src + pos);
+        }
+        if (message != NULL) {
+            return message;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Source file of compressFile / decompressFile, mapped read-only in one piece.
+ */
+typedef struct {
+    int fd;
+    const uint8_t *map;
+    size_t size;
+    dev_t device;
+    ino_t inode;
+} file_source_t;
+
+static void throw_io_error(JNIEnv *env, const char *action, const char *path, int error_number) {
+    char message[1024];
+    if (error_number != 0) {
+        snprintf(message, sizeof(message), "[Error OpenZL JNI] %s %s: %s", action, path, strerror(error_number));
+    } else {
+        snprintf(message, sizeof(message), "[Error OpenZL JNI] %s %s", action, path);
+    }
+    throw_exception(env, jni_cache.io_exception, message);
+}
+
+static int file_source_open(file_source_t *source, const char *path) {
+    source->map = NULL;
+    source->size = 0;
+    source->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (source->fd < 0) {
         return -1;
     }
     
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    if (src_data == NULL) {
-        throw_out_of_memory(env);
+    struct stat st;
+    if (fstat(source->fd, &st) != 0) {
         return -1;
     }
-
-    jbyte *dest_data = (*env)->GetByteArrayElements(env, dest, NULL);
-    if (dest_data == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_out_of_memory(env);
-        return -1;
+    source->size = (size_t)st.st_size;
+    source->device = st.st_dev;
+    source->inode = st.st_ino;
+    if (source->size == 0) {
+        return 0;
     }
-    
-    ZL_Report decompress_report = ZL_decompress(
-        dest_data + dest_off, max_dest_len,
-        src_data + src_off, src_len
-    );
-    
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-    (*env)->ReleaseByteArrayElements(env, dest, dest_data, 0);
-    
-    if (ZL_isError(decompress_report)) {
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(decompress_report)));
+    void *map = mmap(NULL, source->size, PROT_READ, MAP_SHARED, source->fd, 0);
+    if (map == MAP_FAILED) {
         return -1;
     }
-    
-    size_t decompressed_size = ZL_validResult(decompress_report);
-    return (jint)decompressed_size;
+    source->map = map;
+    madvise(map, source->size, MADV_SEQUENTIAL);
+    return 0;
+}
+
+static void file_source_close(file_source_t *source) {
+    if (source->map != NULL) {
+        munmap((void *)source->map, source->size);
+    }
+    if (source->fd >= 0) {
+        close(source->fd);
+    }
+}
+
+static int pwrite_fully(int fd, const uint8_t *data, size_t length, size_t offset) {
+    while (length > 0) {
+        ssize_t written = pwrite(fd, data, length, (off_t)offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+        offset += (size_t)written;
+    }
+    return 0;
 }
 
 /**
- * Decompresses OpenZL-compressed numeric data back into a Java int array.
- * Expects the original data to have been compressed as 32-bit signed integers.
- * Returns a new int array with the decompressed values, or throws an exception on failure.
+ * Drops [offset, offset + length) of a file from the page cache once a batch is done with
+ * it, and for the source also from the mapping, so streaming a file larger than RAM does
+ * not evict everything else. Writes are started first so the dirty pages can be dropped.
  */
-JNIEXPORT jintArray JNICALL
-Java_net_openzl_OpenZLJNI_decompressNumericInts(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
-    if (decompressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
-        return NULL;
-    }
-    
-    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
-    
-    jsize src_len = (*env)->GetArrayLength(env, src);
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    
-    if (src_data == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
+static void drop_file_range(int fd, size_t offset, size_t length, int written) {
+#if defined(__linux__)
+    if (written) {
+        sync_file_range(fd, (off_t)offset, (off_t)length, SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    }
+#else
+    (void)written;
+#endif
+#if defined(POSIX_FADV_DONTNEED)
+    posix_fadvise(fd, (off_t)offset, (off_t)length, POSIX_FADV_DONTNEED);
+#else
+    (void)fd;
+    (void)offset;
+    (void)length;
+#endif
+}
+
+static void drop_source_range(const file_source_t *source, size_t offset, size_t length) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = offset / page * page;
+    madvise((void *)(source->map + start), offset + length - start, MADV_DONTNEED);
+    drop_file_range(source->fd, start, offset + length - start, 0);
+}
+
+/**
+ * Blocks handed to the pool per round: a few per worker so they stay busy, capped so the
+ * slot buffers stay under FILE_BATCH_BYTES however large the file is.
+ */
+#define FILE_BATCH_BLOCKS_PER_WORKER 2
+#define FILE_BATCH_BYTES ((size_t)256 * 1024 * 1024)
+
+static size_t file_batch_blocks(const parallel_runtime_t *runtime, jint threads, size_t slot_size, size_t count) {
+    size_t workers = threads <= 0 || threads > runtime->size ? (size_t)runtime->size : (size_t)threads;
+    size_t batch = workers * FILE_BATCH_BLOCKS_PER_WORKER;
+    if (batch > FILE_BATCH_BYTES / slot_size) {
+        batch = FILE_BATCH_BYTES / slot_size;
     }
-    
-    ZL_Report size_report = ZL_getDecompressedSize(src_data, src_len);
-    if (ZL_isError(size_report)) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(size_report)));
-        return NULL;
+    if (batch > count) {
+        batch = count;
     }
-    
-    size_t decompressed_size = ZL_validResult(size_report);
-    
-    void *decompressed_data = malloc(decompressed_size);
-    if (decompressed_data == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
+    return batch == 0 ? 1 : batch;
+}
+
+typedef struct {
+    jint graph_id;
+    size_t block_size;
+    jint threads;
+    jboolean drop_cache;
+    jboolean io_uring;
+} file_options_t;
+
+/**
+ * Returned by a round loop that cannot run here, such as io_uring on a kernel without it,
+ * so the caller falls back to the mapped loop.
+ */
+#define FILE_ROUNDS_UNAVAILABLE ((jlong)-2)
+
+/**
+ * compressFile's round loop over the mapped source: each round of blocks is compressed on
+ * the pool into one set of slots, packed, and written with a single pwrite. Returns the
+ * end offset of the last block, or -1 if an error occurs (exception thrown).
+ */
+static jlong compress_rounds_mapped(JNIEnv *env, scratch_scope_t *scope, parallel_compress_job_t *job,
+                                   uint32_t *compressed_sizes, size_t count, const file_source_t *source, int fd,
+                                   const char *dest_path, jint threads, jboolean drop_cache) {
+    size_t block_size = job->block_size;
+    size_t batch = file_batch_blocks(job->runtime, threads, job->slot_size, count);
+    job->slots = scratch_alloc(scope, batch * job->slot_size);
+    if (job->slots == NULL) {
         throw_out_of_memory(env);
-        return NULL;
+        return -1;
     }
     
-    ZL_OutputInfo outputInfo;
-    ZL_Report decompress_report = ZL_DCtx_decompressTyped(
-        decompressor->ctx,
-        &outputInfo,
-        decompressed_data, decompressed_size,
-        src_data, src_len
-    );
-    
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-    
-    if (ZL_isError(decompress_report)) {
-        free(decompressed_data);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(decompress_report)));
-        return NULL;
+    size_t pos = CONTAINER_HEADER_SIZE;
+    for (size_t first = 0; first < count; first += batch) {
+        size_t n = count - first < batch ? count - first : batch;
+        size_t offset = first * block_size;
+        job->src = source->map + offset;
+        job->src_size = source->size - offset < n * block_size ? source->size - offset : n * block_size;
+        job->compressed_sizes = compressed_sizes + first;
+        openzl_pool_run(job->runtime->pool, n, threads, parallel_compress_block, job);
+        if (atomic_load(&job->error.failed)) {
+            parallel_throw(env, &job->error);
+            return -1;
+        }
+        
+        size_t length = pack_blocks(job, n);
+        if (pwrite_fully(fd, job->slots, length, pos) != 0) {
+            throw_io_error(env, "Failed to write", dest_path, errno);
+            return -1;
+        }
+        if (drop_cache) {
+            drop_source_range(source, offset, job->src_size);
+            drop_file_range(fd, pos, length, 1);
+        }
+        pos += length;
+    }
+    return (jlong)pos;
+}
+
+#if defined(OPENZL_JNI_HAVE_IO_URING)
+
+/**
+ * Upper bound on each of the four buffer sets registered with the ring. Registered buffers
+ * are pinned, so this stays well below FILE_BATCH_BYTES.
+ */
+#define URING_SET_BYTES ((size_t)64 * 1024 * 1024)
+
+/**
+ * One read or write on the ring. Short transfers are queued again for the rest, so the op
+ * is finished once done reaches length.
+ */
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t offset;
+    size_t done;
+    int buffer;
+    int write;
+} uring_op_t;
+
+typedef struct {
+    struct io_uring ring;
+    int src_fd;
+    int dest_fd;
+    int fixed;
+    size_t in_flight;
+    int error;
+    int error_write;
+} uring_io_t;
+
+static void uring_fail(uring_io_t *io, int error_number, int write) {
+    if (io->error == 0) {
+        io->error = error_number;
+        io->error_write = write;
     }
-    
-    jsize array_len = outputInfo.numElts;
-    jintArray result = (*env)->NewIntArray(env, array_len);
-    if (result == NULL) {
-        free(decompressed_data);
-        throw_out_of_memory(env);
-        return NULL;
+}
+
+static void uring_queue(uring_io_t *io, uring_op_t *op) {
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&io->ring);
+    if (sqe == NULL) {
+        io_uring_submit(&io->ring);
+        sqe = io_uring_get_sqe(&io->ring);
+    }
+    if (sqe == NULL) {
+        uring_fail(io, EBUSY, op->write);
+        return;
+    }
+    
+    uint8_t *data = op->data + op->done;
+    unsigned length = (unsigned)(op->length - op->done);
+    off_t offset = (off_t)(op->offset + op->done);
+    if (op->write) {
+        if (io->fixed) {
+            io_uring_prep_write_fixed(sqe, io->dest_fd, data, length, offset, op->buffer);
+        } else {
+            io_uring_prep_write(sqe, io->dest_fd, data, length, offset);
+        }
+    } else {
+        if (io->fixed) {
+            io_uring_prep_read_fixed(sqe, io->src_fd, data, length, offset, op->buffer);
+        } else {
+            io_uring_prep_read(sqe, io->src_fd, data, length, offset);
+        }
+    }
+    io_uring_sqe_set_data(sqe, op);
+    io->in_flight++;
+}
+
+static void uring_complete(uring_io_t *io, uring_op_t *op, int result) {
+    io->in_flight--;
+    if (result == -EINTR || result == -EAGAIN) {
+        result = 0;
+    } else if (result < 0) {
+        uring_fail(io, -result, op->write);
+        return;
+    } else if (result == 0) {
+        uring_fail(io, EIO, op->write);
+        return;
+    }
+    op->done += (size_t)result;
+    if (op->done < op->length && io->error == 0) {
+        uring_queue(io, op);
     }
-    
-    (*env)->SetIntArrayRegion(env, result, 0, array_len, (jint *)decompressed_data);
-    free(decompressed_data);
-    
-    return result;
 }
 
 /**
- * Decompresses OpenZL-compressed numeric data back into a Java long array.
- * Expects the original data to have been compressed as 64-bit signed integers.
- * Returns a new long array with the decompressed values, or throws an exception on failure.
+ * Submits everything queued and reaps completions until all count ops are finished or one
+ * fails. Returns 0, or -1 with io->error set.
  */
-JNIEXPORT jlongArray JNICALL
-Java_net_openzl_OpenZLJNI_decompressNumericLongs(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
-    if (decompressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
-        return NULL;
+static int uring_wait(uring_io_t *io, uring_op_t *ops, size_t count) {
+    for (size_t i = 0; i < count && io->error == 0; i++) {
+        while (io->error == 0 && ops[i].done < ops[i].length) {
+            if (io->in_flight == 0) {
+                uring_fail(io, EIO, ops[i].write);
+                break;
+            }
+            int result = io_uring_submit_and_wait(&io->ring, 1);
+            if (result < 0 && result != -EINTR) {
+                uring_fail(io, -result, ops[i].write);
+                break;
+            }
+            struct io_uring_cqe *cqe;
+            while (io_uring_peek_cqe(&io->ring, &cqe) == 0) {
+                uring_op_t *op = io_uring_cqe_get_data(cqe);
+                int res = cqe->res;
+                io_uring_cqe_seen(&io->ring, cqe);
+                uring_complete(io, op, res);
+            }
+        }
+    }
+    return io->error == 0 ? 0 : -1;
+}
+
+/**
+ * Waits out every op still in flight without queueing more, so the buffers can be freed.
+ */
+static void uring_drain(uring_io_t *io) {
+    io_uring_submit(&io->ring);
+    while (io->in_flight > 0) {
+        struct io_uring_cqe *cqe;
+        int result = io_uring_wait_cqe(&io->ring, &cqe);
+        if (result == -EINTR) {
+            continue;
+        }
+        if (result < 0) {
+            break;
+        }
+        io_uring_cqe_seen(&io->ring, cqe);
+        io->in_flight--;
+    }
+}
+
+/**
+ * Queues one read per block of the round of n blocks starting at block first, into the
+ * input set at data.
+ */
+static void uring_read_round(uring_io_t *io, uring_op_t *reads, uint8_t *data, int buffer, size_t first,
+                             size_t n, size_t block_size, size_t src_size) {
+    for (size_t i = 0; i < n; i++) {
+        size_t offset = (first + i) * block_size;
+        uring_op_t *op = &reads[i];
+        op->data = data + i * block_size;
+        op->length = src_size - offset < block_size ? src_size - offset : block_size;
+        op->offset = offset;
+        op->done = 0;
+        op->buffer = buffer;
+        op->write = 0;
+        uring_queue(io, op);
+    }
+    io_uring_submit(&io->ring);
+}
+
+/**
+ * compressFile's round loop with reads and writes on io_uring instead of the mapping and
+ * pwrite. Two input and two output buffer sets are registered with the ring. While the
+ * pool compresses round r out of one input set, a read per block of round r + 1 is already
+ * queued into the other, and the output of round r - 1 is still being written from the
+ * other output set, so from fast storage the compressor never waits on a syscall. Returns
+ * the end offset of the last block, -1 if an error occurs (exception thrown), or
+ * FILE_ROUNDS_UNAVAILABLE when no ring can be created.
+ */
+static jlong compress_rounds_uring(JNIEnv *env, scratch_scope_t *scope, parallel_compress_job_t *job,
+                                  uint32_t *compressed_sizes, size_t count, const file_source_t *source, int fd,
+                                  const char *src_path, const char *dest_path, jint threads, jboolean drop_cache) {
+    size_t block_size = job->block_size;
+    size_t slot_size = job->slot_size;
+    size_t batch = file_batch_blocks(job->runtime, threads, slot_size, count);
+    if (batch > URING_SET_BYTES / slot_size) {
+        batch = URING_SET_BYTES / slot_size == 0 ? 1 : URING_SET_BYTES / slot_size;
+    }
+    uint8_t *input = scratch_alloc(scope, 2 * batch * block_size);
+    uint8_t *output = scratch_alloc(scope, 2 * batch * slot_size);
+    uring_op_t *reads = scratch_alloc(scope, 2 * batch * sizeof(uring_op_t));
+    if (input == NULL || output == NULL || reads == NULL) {
+        throw_out_of_memory(env);
+        return -1;
     }
     
-    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
-    
-    jsize src_len = (*env)->GetArrayLength(env, src);
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    
-    if (src_data == NULL) {
+    uring_io_t io;
+    if (io_uring_queue_init((unsigned)(2 * batch + 2), &io.ring, 0) != 0) {
+        return FILE_ROUNDS_UNAVAILABLE;
+    }
+    io.src_fd = source->fd;
+    io.dest_fd = fd;
+    io.in_flight = 0;
+    io.error = 0;
+    io.error_write = 0;
+    struct iovec buffers[4] = {
+        { input, batch * block_size },
+        { input + batch * block_size, batch * block_size },
+        { output, batch * slot_size },
+        { output + batch * slot_size, batch * slot_size },
+    };
+    io.fixed = io_uring_register_buffers(&io.ring, buffers, 4) == 0;
+    
+    uring_op_t writes[2];
+    memset(writes, 0, sizeof(writes));
+    size_t rounds = (count + batch - 1) / batch;
+    if (rounds > 0) {
+        uring_read_round(&io, reads, buffers[0].iov_base, 0, 0, count < batch ? count : batch, block_size,
+                         source->size);
+    }
+    
+    size_t pos = CONTAINER_HEADER_SIZE;
+    for (size_t round = 0; round < rounds; round++) {
+        int set = (int)(round & 1);
+        size_t first = round * batch;
+        size_t n = count - first < batch ? count - first : batch;
+        size_t offset = first * block_size;
+        if (uring_wait(&io, reads + set * batch, n) != 0) {
+            break;
+        }
+        if (round + 1 < rounds) {
+            size_t next = first + n;
+            uring_read_round(&io, reads + (1 - set) * batch, buffers[1 - set].iov_base, 1 - set, next,
+                             count - next < batch ? count - next : batch, block_size, source->size);
+        }
+        if (uring_wait(&io, &writes[set], 1) != 0) {
+            break;
+        }
+        if (drop_cache && writes[set].length > 0) {
+            drop_file_range(fd, writes[set].offset, writes[set].length, 1);
+        }
+        
+        job->src = buffers[set].iov_base;
+        job->src_size = source->size - offset < n * block_size ? source->size - offset : n * block_size;
+        job->slots = buffers[2 + set].iov_base;
+        job->compressed_sizes = compressed_sizes + first;
+        openzl_pool_run(job->runtime->pool, n, threads, parallel_compress_block, job);
+        if (atomic_load(&job->error.failed)) {
+            break;
+        }
+        if (drop_cache) {
+            drop_file_range(source->fd, offset, job->src_size, 0);
+        }
+        
+        uring_op_t *write = &writes[set];
+        write->data = job->slots;
+        write->length = pack_blocks(job, n);
+        write->offset = pos;
+        write->done = 0;
+        write->buffer = 2 + set;
+        write->write = 1;
+        uring_queue(&io, write);
+        io_uring_submit(&io.ring);
+        pos += write->length;
+    }
+    
+    if (io.error == 0 && !atomic_load(&job->error.failed)) {
+        uring_wait(&io, writes, 2);
+    }
+    uring_drain(&io);
+    io_uring_queue_exit(&io.ring);
+    
+    if (atomic_load(&job->error.failed)) {
+        parallel_throw(env, &job->error);
+        return -1;
+    }
+    if (io.error != 0) {
+        throw_io_error(env, io.error_write ? "Failed to write" : "Failed to read",
+                       io.error_write ? dest_path : src_path, io.error);
+        return -1;
+    }
+    for (int set = 0; set < 2 && drop_cache; set++) {
+        if (writes[set].length > 0) {
+            drop_file_range(fd, writes[set].offset, writes[set].length, 1);
+        }
+    }
+    return (jlong)pos;
+}
+
+#endif
+
+static jlong compress_file_blocks(JNIEnv *env, scratch_scope_t *scope, const file_source_t *source, int fd,
+                                  const char *src_path, const char *dest_path, const file_options_t *options) {
+    size_t block_size = options->block_size;
+    parallel_runtime_t *runtime = parallel_runtime_get();
+    size_t count = parallel_block_count(source->size, block_size);
+    if (runtime == NULL) {
         throw_out_of_memory(env);
-        return NULL;
+        return -1;
     }
-    
-    ZL_Report size_report = ZL_getDecompressedSize(src_data, src_len);
-    if (ZL_isError(size_report)) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(size_report)));
-        return NULL;
+    if (count > UINT32_MAX) {
+        throw_exception(env, jni_cache.illegal_argument_exception,
+                        "[Error OpenZL JNI] Too many blocks for one container; use a larger block size");
+        return -1;
     }
-    
-    size_t decompressed_size = ZL_validResult(size_report);
-    
-    void *decompressed_data = malloc(decompressed_size);
-    if (decompressed_data == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
+    uint32_t *compressed_sizes = scratch_alloc(scope, (count + 1) * sizeof(uint32_t));
+    uint8_t *footer = scratch_alloc(scope, container_footer_size(count));
+    if (compressed_sizes == NULL || footer == NULL) {
         throw_out_of_memory(env);
-        return NULL;
+        return -1;
     }
     
-    ZL_OutputInfo outputInfo;
-    ZL_Report decompress_report = ZL_DCtx_decompressTyped(
-        decompressor->ctx,
-        &outputInfo,
-        decompressed_data, decompressed_size,
-        src_data, src_len
-    );
+    uint8_t header[CONTAINER_HEADER_SIZE];
+    container_header(header, block_size);
+    if (pwrite_fully(fd, header, CONTAINER_HEADER_SIZE, 0) != 0) {
+        throw_io_error(env, "Failed to write", dest_path, errno);
+        return -1;
+    }
     
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
+    parallel_compress_job_t job;
+    job.runtime = runtime;
+    job.graph_slot = graph_slot(options->graph_id);
+    job.block_size = block_size;
+    job.dest = NULL;
+    job.slot_size = CONTAINER_BLOCK_HEADER_SIZE + ZL_compressBound(block_size);
+    atomic_init(&job.error.failed, 0);
+    job.error.message = NULL;
     
-    if (ZL_isError(decompress_report)) {
-        free(decompressed_data);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(decompress_report)));
-        return NULL;
+    jlong end = FILE_ROUNDS_UNAVAILABLE;
+#if defined(OPENZL_JNI_HAVE_IO_URING)
+    if (options->io_uring) {
+        end = compress_rounds_uring(env, scope, &job, compressed_sizes, count, source, fd, src_path, dest_path,
+                                    options->threads, options->drop_cache);
+    }
+#endif
+    if (end == FILE_ROUNDS_UNAVAILABLE) {
+        end = compress_rounds_mapped(env, scope, &job, compressed_sizes, count, source, fd, dest_path,
+                                     options->threads, options->drop_cache);
+    }
+    if (end < 0) {
+        return -1;
     }
     
-    jsize array_len = outputInfo.numElts;
-    jlongArray result = (*env)->NewLongArray(env, array_len);
-    if (result == NULL) {
-        free(decompressed_data);
+    size_t pos = (size_t)end;
+    size_t footer_size = container_footer(footer, pos, compressed_sizes, count, source->size, block_size);
+    if (pwrite_fully(fd, footer, footer_size, pos) != 0) {
+        throw_io_error(env, "Failed to write", dest_path, errno);
+        return -1;
+    }
+    return (jlong)(pos + footer_size);
+}
+
+static jlong decompress_file_blocks(JNIEnv *env, scratch_scope_t *scope, const file_source_t *source, int fd,
+                                    const char *src_path, const char *dest_path, const file_options_t *options) {
+    jint threads = options->threads;
+    container_table_t table;
+    const char *message = container_table_read(scope, source->map, source->size, &table);
+    if (message != NULL) {
+        throw_openzl_exception(env, message);
+        return -1;
+    }
+    parallel_runtime_t *runtime = parallel_runtime_get();
+    if (runtime == NULL) {
         throw_out_of_memory(env);
-        return NULL;
+        return -1;
     }
-    
-    (*env)->SetLongArrayRegion(env, result, 0, array_len, (jlong *)decompressed_data);
-    free(decompressed_data);
-    
-    return result;
+    size_t batch = file_batch_blocks(runtime, threads, table.block_size, table.count);
+    uint8_t *slots = scratch_alloc(scope, batch * table.block_size);
+    jlong *raw_offsets = scratch_alloc(scope, batch * sizeof(jlong));
+    if (slots == NULL || raw_offsets == NULL) {
+        throw_out_of_memory(env);
+        return -1;
+    }
+    for (size_t i = 0; i < batch; i++) {
+        raw_offsets[i] = (jlong)(i * table.block_size);
+    }
+    
+    parallel_decompress_job_t job;
+    job.runtime = runtime;
+    job.src = source->map;
+    job.dest = slots;
+    job.raw_offsets = raw_offsets;
+    atomic_init(&job.error.failed, 0);
+    job.error.message = NULL;
+    
+    size_t pos = 0;
+    for (size_t first = 0; first < table.count; first += batch) {
+        size_t n = table.count - first < batch ? table.count - first : batch;
+        job.frame_offsets = table.frame_offsets + first;
+        job.compressed_sizes = table.compressed_sizes + first;
+        job.raw_sizes = table.raw_sizes + first;
+        openzl_pool_run(runtime->pool, n, threads, parallel_decompress_block, &job);
+        if (atomic_load(&job.error.failed)) {
+            parallel_throw(env, &job.error);
+            return -1;
+        }
+        
+        size_t batch_start = pos;
+        for (size_t i = 0; i < n; i++) {
+            if (pwrite_fully(fd, slots + i * table.block_size, (size_t)job.raw_sizes[i], pos) != 0) {
+                throw_io_error(env, "Failed to write", dest_path, errno);
+                return -1;
+            }
+            pos += (size_t)job.raw_sizes[i];
+        }
+        if (options->drop_cache) {
+            size_t frames_start = (size_t)job.frame_offsets[0] - CONTAINER_BLOCK_HEADER_SIZE;
+            size_t frames_end = (size_t)job.frame_offsets[n - 1] + (size_t)job.compressed_sizes[n - 1];
+            drop_source_range(source, frames_start, frames_end - frames_start);
+            drop_file_range(fd, batch_start, pos - batch_start, 1);
+        }
+    }
+    return (jlong)pos;
 }
 
+typedef jlong (*file_blocks_fn)(JNIEnv *env, scratch_scope_t *scope, const file_source_t *source, int fd,
+                                const char *src_path, const char *dest_path, const file_options_t *options);
+
 /**
- * Decompresses OpenZL-compressed numeric data back into a Java float array.
- * Expects the original data to have been compressed as 32-bit floating-point values.
- * Returns a new float array with the decompressed values, or throws an exception on failure.
+ * Opens and maps src_path, creates or truncates dest_path, runs fn over them and closes
+ * both, reporting open and close failures as IOException. dest_path is removed again if
+ * fn or the final close fails.
  */
-JNIEXPORT jfloatArray JNICALL
-Java_net_openzl_OpenZLJNI_decompressNumericFloats(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
-    if (decompressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
-        return NULL;
-    }
-    
-    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
-    
-    jsize src_len = (*env)->GetArrayLength(env, src);
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    
-    if (src_data == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
+static jlong with_files(JNIEnv *env, scratch_scope_t *scope, const char *src_path, const char *dest_path,
+                        file_blocks_fn fn, const file_options_t *options) {
+    file_source_t source;
+    if (file_source_open(&source, src_path) != 0) {
+        int error_number = errno;
+        file_source_close(&source);
+        throw_io_error(env, "Failed to read", src_path, error_number);
+        return -1;
     }
-    
-    ZL_Report size_report = ZL_getDecompressedSize(src_data, src_len);
-    if (ZL_isError(size_report)) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(size_report)));
-        return NULL;
+    int fd = open(dest_path, O_WRONLY | O_CREAT | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        int error_number = errno;
+        file_source_close(&source);
+        throw_io_error(env, "Failed to create", dest_path, error_number);
+        return -1;
     }
     
-    size_t decompressed_size = ZL_validResult(size_report);
-    
-    void *decompressed_data = malloc(decompressed_size);
-    if (decompressed_data == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_out_of_memory(env);
-        return NULL;
+    /*
+     * Truncating the mapped source would turn the next read of the mapping into SIGBUS, so
+     * the destination is only truncated once it is known to be a different file.
+     */
+    struct stat st;
+    const char *failure = NULL;
+    int error_number = 0;
+    if (fstat(fd, &st) != 0) {
+        failure = "Failed to create";
+        error_number = errno;
+    } else if (st.st_dev == source.device && st.st_ino == source.inode) {
+        failure = "Source and destination are the same file:";
+    } else if (ftruncate(fd, 0) != 0) {
+        failure = "Failed to truncate";
+        error_number = errno;
+    }
+    if (failure != NULL) {
+        close(fd);
+        file_source_close(&source);
+        throw_io_error(env, failure, dest_path, error_number);
+        return -1;
     }
     
-    ZL_OutputInfo outputInfo;
-    ZL_Report decompress_report = ZL_DCtx_decompressTyped(
-        decompressor->ctx,
-        &outputInfo,
-        decompressed_data, decompressed_size,
-        src_data, src_len
-    );
-    
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-    
-    if (ZL_isError(decompress_report)) {
-        free(decompressed_data);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(decompress_report)));
-        return NULL;
+    jlong result = fn(env, scope, &source, fd, src_path, dest_path, options);
+    if (close(fd) != 0 && result >= 0) {
+        throw_io_error(env, "Failed to write", dest_path, errno);
+        result = -1;
     }
-    
-    jsize array_len = outputInfo.numElts;
-    jfloatArray result = (*env)->NewFloatArray(env, array_len);
-    if (result == NULL) {
-        free(decompressed_data);
-        throw_out_of_memory(env);
-        return NULL;
+    if (result < 0) {
+        unlink(dest_path);
     }
-    
-    (*env)->SetFloatArrayRegion(env, result, 0, array_len, (jfloat *)decompressed_data);
-    free(decompressed_data);
-    
+    file_source_close(&source);
     return result;
 }
 
 /**
- * Decompresses OpenZL-compressed numeric data back into a Java double array.
- * Expects the original data to have been compressed as 64-bit floating-point values.
- * Returns a new double array with the decompressed values, or throws an exception on failure.
+ * Copies a NUL-terminated path, encoded by OpenZLFiles in sun.jnu.encoding, into scratch.
  */
-JNIEXPORT jdoubleArray JNICALL
-Java_net_openzl_OpenZLJNI_decompressNumericDoubles(JNIEnv *env, jclass clazz, jlong decompressor_ptr, jbyteArray src) {
-    if (decompressor_ptr == 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Invalid decompressor");
-        return NULL;
-    }
-    
-    openzl_decompressor_t *decompressor = (openzl_decompressor_t *)(uintptr_t)decompressor_ptr;
-    
-    jsize src_len = (*env)->GetArrayLength(env, src);
-    jbyte *src_data = (*env)->GetByteArrayElements(env, src, NULL);
-    
-    if (src_data == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
-    }
-    
-    ZL_Report size_report = ZL_getDecompressedSize(src_data, src_len);
-    if (ZL_isError(size_report)) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(size_report)));
-        return NULL;
-    }
-    
-    size_t decompressed_size = ZL_validResult(size_report);
-    
-    void *decompressed_data = malloc(decompressed_size);
-    if (decompressed_data == NULL) {
-        (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
+static const char *file_path(JNIEnv *env, scratch_scope_t *scope, jbyteArray path) {
+    jsize length = (*env)->GetArrayLength(env, path);
+    char *copy = scratch_alloc(scope, (size_t)length + 1);
+    if (copy == NULL) {
         throw_out_of_memory(env);
         return NULL;
     }
-    
-    ZL_OutputInfo outputInfo;
-    ZL_Report decompress_report = ZL_DCtx_decompressTyped(
-        decompressor->ctx,
-        &outputInfo,
-        decompressed_data, decompressed_size,
-        src_data, src_len
-    );
-    
-    (*env)->ReleaseByteArrayElements(env, src, src_data, JNI_ABORT);
-    
-    if (ZL_isError(decompress_report)) {
-        free(decompressed_data);
-        throw_openzl_exception(env, ZL_ErrorCode_toString(ZL_errorCode(decompress_report)));
-        return NULL;
+    (*env)->GetByteArrayRegion(env, path, 0, length, (jbyte *)copy);
+    copy[length] = '\0';
+    return copy;
+}
+
+static jlong run_file_job(JNIEnv *env, jbyteArray src_path, jbyteArray dest_path, file_blocks_fn fn,
+                          const file_options_t *options) {
+    if (src_path == NULL || dest_path == NULL) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Paths cannot be null");
+        return -1;
     }
     
-    jsize array_len = outputInfo.numElts;
-    jdoubleArray result = (*env)->NewDoubleArray(env, array_len);
-    if (result == NULL) {
-        free(decompressed_data);
-        throw_out_of_memory(env);
-        return NULL;
+    scratch_scope_t scope = scratch_begin();
+    jlong result = -1;
+    const char *src = file_path(env, &scope, src_path);
+    const char *dest = src == NULL ? NULL : file_path(env, &scope, dest_path);
+    if (dest != NULL) {
+        result = with_files(env, &scope, src, dest, fn, options);
     }
-    
-    (*env)->SetDoubleArrayRegion(env, result, 0, array_len, (jdouble *)decompressed_data);
-    free(decompressed_data);
-    
+    scratch_end(&scope);
     return result;
 }
 
+#endif
 
-JNIEXPORT jint JNICALL
-Java_net_openzl_OpenZLJNI_compressBound(JNIEnv *env, jclass clazz, jint src_len) {
-    return (jint)ZL_compressBound(src_len);
+/**
+ * Compresses the file at srcPath into an indexed block container at destPath without
+ * passing payload through the JVM: the source is mapped, blocks are compressed in rounds
+ * on the native worker pool (threads caps the workers, <= 0 uses all of them) and written
+ * in order with pwrite. With dropCache, each round's input and output ranges are dropped
+ * from the page cache behind it. With ioUring, reads and writes go through io_uring when
+ * the library was built with it and the kernel allows a ring (see compress_rounds_uring),
+ * and through the mapping otherwise. Returns the container size, or -1 if an error occurs
+ * (exception thrown). POSIX only; throws UnsupportedOperationException elsewhere.
+ */
+JNIEXPORT jlong JNICALL
+Java_net_openzl_OpenZLJNI_compressFile(JNIEnv *env, jclass clazz, jbyteArray src_path, jbyteArray dest_path,
+                                      jint graph_id, jint block_size, jint threads, jboolean drop_cache,
+                                      jboolean io_uring) {
+    if (block_size < CONTAINER_MIN_BLOCK_SIZE || block_size > CONTAINER_MAX_BLOCK_SIZE) {
+        throw_exception(env, jni_cache.illegal_argument_exception, "[Error OpenZL JNI] Invalid block size");
+        return -1;
+    }
+#if defined(_WIN32)
+    throw_exception(env, jni_cache.unsupported_operation_exception,
+                    "[Error OpenZL JNI] Native file compression is not available on Windows");
+    return -1;
+#else
+    file_options_t options = { graph_id, (size_t)block_size, threads, drop_cache, io_uring };
+    return run_file_job(env, src_path, dest_path, compress_file_blocks, &options);
+#endif
 }
 
 /**
- * Analyzes OpenZL-compressed data and returns metadata about its contents.
- * Returns a CompressionInfo object containing decompressed size, compressed size,
- * data type (e.g., SERIAL, NUMERIC), and inferred compression graph.
- * Throws an exception if the input is invalid or metadata cannot be extracted.
+ * Decompresses the block container at srcPath into destPath, the reverse of compressFile:
+ * the block table is read from the mapped source, and rounds of blocks are decoded on the
+ * worker pool into block-sized buffers and written in order. Returns the number of bytes
+ * written, or -1 if an error occurs (exception thrown).
  */
+JNIEXPORT jlong JNICALL
+Java_net_openzl_OpenZLJNI_decompressFile(JNIEnv *env, jclass clazz, jbyteArray src_path, jbyteArray dest_path,
+                                        jint threads, jboolean drop_cache) {
+#if defined(_WIN32)
+    throw_exception(env, jni_cache.unsupported_operation_exception,
+                    "[Error OpenZL JNI] Native file decompression is not available on Windows");
+    return -1;
+#else
+    file_options_t options = { 0, 0, threads, drop_cache, JNI_FALSE };
+    return run_file_job(env, src_path, dest_path, decompress_file_blocks, &options);
+#endif
+}
 
-JNIEXPORT jobject JNICALL
-Java_net_openzl_OpenZLJNI_getCompressionInfo(JNIEnv *env, jclass clazz, jbyteArray compressed_data) {
-    if (compressed_data == NULL) {
-        throw_exception(env, "java/lang/IllegalArgumentException", "[Error OpenZL JNI] Compressed data cannot be null");
+/**
+ * Whether compressFile can use io_uring: the library was built with liburing and this
+ * process may create a ring, which container seccomp profiles often forbid.
+ */
+JNIEXPORT jboolean JNICALL
+Java_net_openzl_OpenZLJNI_ioUringAvailable(JNIEnv *env, jclass clazz) {
+#if defined(OPENZL_JNI_HAVE_IO_URING)
+    struct io_uring ring;
+    if (io_uring_queue_init(2, &ring, 0) != 0) {
+        return JNI_FALSE;
+    }
+    io_uring_queue_exit(&ring);
+    return JNI_TRUE;
+#else
+    return JNI_FALSE;
+#endif
+}
+
+#define NATIVE_METHOD(name, signature) \
+    { (char *)#name, (char *)(signature), (void *)Java_net_openzl_OpenZLJNI_##name }
+
+static const JNINativeMethod openzl_jni_methods[] = {
+    NATIVE_METHOD(nativeInit, "()V"),
+    NATIVE_METHOD(nativeShutdown, "()V"),
+    NATIVE_METHOD(setCriticalArrayThreshold, "(I)V"),
+    NATIVE_METHOD(setScratchArenaRetainLimit, "(J)V"),
+    NATIVE_METHOD(getScratchArenaStats, "()[J"),
+    NATIVE_METHOD(createCompressor, "(I)J"),
+    NATIVE_METHOD(destroyCompressor, "(J)V"),
+    NATIVE_METHOD(createDecompressor, "()J"),
+    NATIVE_METHOD(destroyDecompressor, "(J)V"),
+    NATIVE_METHOD(compressSerial, "(J[BII)[B"),
+    NATIVE_METHOD(compressSerialToBuffer, "(J[BII[BII)I"),
+    NATIVE_METHOD(compressDirect, "(JLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;II)I"),
+    NATIVE_METHOD(compressNumeric, "(J[BII)[B"),
+    NATIVE_METHOD(compressNumericInts, "(J[I)[B"),
+    NATIVE_METHOD(compressNumericLongs, "(J[J)[B"),
+    NATIVE_METHOD(compressNumericFloats, "(J[F)[B"),
+    NATIVE_METHOD(compressNumericDoubles, "(J[D)[B"),
+    NATIVE_METHOD(decompressSerial, "(J[BII)[B"),
+    NATIVE_METHOD(decompressSerialToBuffer, "(J[BII[BII)I"),
+    NATIVE_METHOD(decompressDirect, "(JLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;II)I"),
+    NATIVE_METHOD(decompressNumeric, "(J[BII)[B"),
+    NATIVE_METHOD(decompressNumericInts, "(J[B)[I"),
+    NATIVE_METHOD(decompressNumericLongs, "(J[B)[J"),
+    NATIVE_METHOD(decompressNumericFloats, "(J[B)[F"),
+    NATIVE_METHOD(decompressNumericDoubles, "(J[B)[D"),
+    NATIVE_METHOD(decompressNumericIntsInto, "(J[BII[II)I"),
+    NATIVE_METHOD(decompressNumericLongsInto, "(J[BII[JI)I"),
+    NATIVE_METHOD(decompressNumericFloatsInto, "(J[BII[FI)I"),
+    NATIVE_METHOD(decompressNumericDoublesInto, "(J[BII[DI)I"),
+    NATIVE_METHOD(getCompressionInfo, "([B)Lnet/openzl/CompressionInfo;"),
+    NATIVE_METHOD(compressBound, "(J)J"),
+    NATIVE_METHOD(currentCpu, "()I"),
+    NATIVE_METHOD(compressBatch, "(J[Ljava/lang/Object;[I[I[I)[B"),
+    NATIVE_METHOD(decompressBatch, "(J[B[I)[[B"),
+    NATIVE_METHOD(compressParallel, "(IJJJJII)J"),
+    NATIVE_METHOD(decompressParallel, "(JJJJ[J[I[J[II)J"),
+    NATIVE_METHOD(scanFrames, "(JJ)[J"),
+    NATIVE_METHOD(scanFramesArray, "([BII)[J"),
+    NATIVE_METHOD(compressFile, "([B[BIIIZZ)J"),
+    NATIVE_METHOD(decompressFile, "([B[BIZ)J"),
+    NATIVE_METHOD(ioUringAvailable, "()Z"),
+};
+
+static jclass find_global_class(JNIEnv *env, const char *name) {
+    jclass local = (*env)->FindClass(env, name);
+    if (local == NULL) {
         return NULL;
     }
-    
-    jsize compressed_len = (*env)->GetArrayLength(env, compressed_data);
-    if (compressed_len <= 0) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Compressed data is empty");
+    jclass global = (*env)->NewGlobalRef(env, local);
+    (*env)->DeleteLocalRef(env, local);
+    return global;
+}
+
+static jobject graph_from_id(JNIEnv *env, jclass graph_class, jmethodID from_id, jint id) {
+    jobject local = (*env)->CallStaticObjectMethod(env, graph_class, from_id, id);
+    if (local == NULL || (*env)->ExceptionCheck(env)) {
         return NULL;
     }
-    
-    jbyte *compressed_bytes = (*env)->GetByteArrayElements(env, compressed_data, NULL);
-    if (compressed_bytes == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
+    jobject global = (*env)->NewGlobalRef(env, local);
+    (*env)->DeleteLocalRef(env, local);
+    return global;
+}
+
+static void delete_global_ref(JNIEnv *env, jobject *ref) {
+    if (*ref != NULL) {
+        (*env)->DeleteGlobalRef(env, *ref);
+        *ref = NULL;
     }
-    
-    ZL_Report compressed_size_result = ZL_getCompressedSize(compressed_bytes, compressed_len);
-    if (ZL_isError(compressed_size_result)) {
-        (*env)->ReleaseByteArrayElements(env, compressed_data, compressed_bytes, JNI_ABORT);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to get compressed size");
-        return NULL;
+}
+
+static void release_jni_cache(JNIEnv *env) {
+    delete_global_ref(env, &jni_cache.openzl_exception);
+    delete_global_ref(env, &jni_cache.out_of_memory_error);
+    delete_global_ref(env, &jni_cache.illegal_argument_exception);
+    delete_global_ref(env, &jni_cache.index_out_of_bounds_exception);
+    delete_global_ref(env, &jni_cache.unsupported_operation_exception);
+    delete_global_ref(env, &jni_cache.io_exception);
+    delete_global_ref(env, &jni_cache.compression_info);
+    delete_global_ref(env, &jni_cache.byte_array);
+    delete_global_ref(env, &jni_cache.graph_zstd);
+    delete_global_ref(env, &jni_cache.graph_numeric);
+    for (int i = 0; i < DATA_TYPE_COUNT; i++) {
+        delete_global_ref(env, &jni_cache.data_types[i]);
     }
-    
-    ZL_FrameInfo *frame_info = ZL_FrameInfo_create(compressed_bytes, compressed_len);
-    if (frame_info == NULL) {
-        (*env)->ReleaseByteArrayElements(env, compressed_data, compressed_bytes, JNI_ABORT);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create frame info");
-        return NULL;
+}
+
+static int init_jni_cache(JNIEnv *env) {
+    jni_cache.openzl_exception = find_global_class(env, "net/openzl/OpenZLException");
+    jni_cache.out_of_memory_error = find_global_class(env, "java/lang/OutOfMemoryError");
+    jni_cache.illegal_argument_exception = find_global_class(env, "java/lang/IllegalArgumentException");
+    jni_cache.index_out_of_bounds_exception = find_global_class(env, "java/lang/IndexOutOfBoundsException");
+    jni_cache.unsupported_operation_exception = find_global_class(env, "java/lang/UnsupportedOperationException");
+    jni_cache.io_exception = find_global_class(env, "java/io/IOException");
+    jni_cache.compression_info = find_global_class(env, "net/openzl/CompressionInfo");
+    jni_cache.byte_array = find_global_class(env, "[B");
+    if (jni_cache.openzl_exception == NULL || jni_cache.out_of_memory_error == NULL
+            || jni_cache.illegal_argument_exception == NULL || jni_cache.index_out_of_bounds_exception == NULL
+            || jni_cache.unsupported_operation_exception == NULL || jni_cache.io_exception == NULL
+            || jni_cache.compression_info == NULL || jni_cache.byte_array == NULL) {
+        return -1;
     }
     
-    ZL_Report decompressed_size_result = ZL_FrameInfo_getDecompressedSize(frame_info, 0);
-    if (ZL_isError(decompressed_size_result)) {
-        ZL_FrameInfo_free(frame_info);
-        (*env)->ReleaseByteArrayElements(env, compressed_data, compressed_bytes, JNI_ABORT);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to get decompressed size");
-        return NULL;
+    jni_cache.compression_info_init = (*env)->GetMethodID(env, jni_cache.compression_info, "<init>",
+                                                          "(JJLnet/openzl/CompressionGraph;Ljava/lang/String;)V");
+    if (jni_cache.compression_info_init == NULL) {
+        return -1;
     }
     
-    ZL_Report output_type_result = ZL_FrameInfo_getOutputType(frame_info, 0);
-    if (ZL_isError(output_type_result)) {
-        ZL_FrameInfo_free(frame_info);
-        (*env)->ReleaseByteArrayElements(env, compressed_data, compressed_bytes, JNI_ABORT);
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to get output type");
-        return NULL;
+    jclass graph_class = (*env)->FindClass(env, "net/openzl/CompressionGraph");
+    if (graph_class == NULL) {
+        return -1;
     }
-    
-    size_t compressed_size = ZL_validResult(compressed_size_result);
-    size_t decompressed_size = ZL_validResult(decompressed_size_result);
-    int output_type = (int)ZL_validResult(output_type_result);
-    
-    const char *data_type_str;
-    switch (output_type) {
-        case 0:
-            data_type_str = "SERIAL";
-            break;
-        case 2:
-            data_type_str = "NUMERIC";
-            break;
-        case 1:
-            data_type_str = "STRUCT";
-            break;
-        case 3:
-            data_type_str = "STRING";
-            break;
-        default:
-            data_type_str = "UNKNOWN";
-            break;
+    jmethodID from_id = (*env)->GetStaticMethodID(env, graph_class, "fromId", "(I)Lnet/openzl/CompressionGraph;");
+    if (from_id != NULL) {
+        jni_cache.graph_zstd = graph_from_id(env, graph_class, from_id, 0);
+        jni_cache.graph_numeric = graph_from_id(env, graph_class, from_id, 1);
     }
-    
-    ZL_FrameInfo_free(frame_info);
-    (*env)->ReleaseByteArrayElements(env, compressed_data, compressed_bytes, JNI_ABORT);
-    
-    jclass compression_info_class = (*env)->FindClass(env, "net/openzl/CompressionInfo");
-    if (compression_info_class == NULL) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to find CompressionInfo class");
-        return NULL;
+    (*env)->DeleteLocalRef(env, graph_class);
+    if (jni_cache.graph_zstd == NULL || jni_cache.graph_numeric == NULL) {
+        return -1;
     }
     
-    jmethodID constructor = (*env)->GetMethodID(env, compression_info_class, "<init>", "(JJLnet/openzl/CompressionGraph;Ljava/lang/String;)V");
-    if (constructor == NULL) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to find CompressionInfo constructor");
-        return NULL;
+    for (int i = 0; i < DATA_TYPE_COUNT; i++) {
+        jstring local = (*env)->NewStringUTF(env, data_type_names[i]);
+        if (local == NULL) {
+            return -1;
+        }
+        jni_cache.data_types[i] = (*env)->NewGlobalRef(env, local);
+        (*env)->DeleteLocalRef(env, local);
+        if (jni_cache.data_types[i] == NULL) {
+            return -1;
+        }
     }
     
-    jclass compression_graph_class = (*env)->FindClass(env, "net/openzl/CompressionGraph");
-    if (compression_graph_class == NULL) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to find CompressionGraph class");
-        return NULL;
+    return 0;
+}
+
+/**
+ * Resolves and pins every class, method ID and constant the entry points need, then binds
+ * all OpenZLJNI natives eagerly with RegisterNatives instead of relying on lazy
+ * name-mangled symbol lookup on first call.
+ */
+JNIEXPORT jint JNICALL
+JNI_OnLoad(JavaVM *vm, void *reserved) {
+    JNIEnv *env;
+    if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_8) != JNI_OK) {
+        return JNI_ERR;
     }
     
-    jmethodID from_id_method = (*env)->GetStaticMethodID(env, compression_graph_class, "fromId", "(I)Lnet/openzl/CompressionGraph;");
-    if (from_id_method == NULL) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to find CompressionGraph.fromId method");
-        return NULL;
+    if (init_jni_cache(env) != 0) {
+        release_jni_cache(env);
+        return JNI_ERR;
     }
-    
-    int graph_id;
-    switch (output_type) {
-        case 2:
-            graph_id = 1;
-            break;
-        case 0:
-            graph_id = 0;
-            break;
-        case 1:
-        case 3:
-        default:
-            graph_id = 0;
-            break;
+    if (scratch_arena_key_init() != 0) {
+        release_jni_cache(env);
+        return JNI_ERR;
     }
     
-    jobject compression_graph = (*env)->CallStaticObjectMethod(env, compression_graph_class, from_id_method, graph_id);
-    if (compression_graph == NULL) {
-        throw_openzl_exception(env, "[Error OpenZL JNI] Failed to create CompressionGraph object");
-        return NULL;
+    jclass jni_class = (*env)->FindClass(env, "net/openzl/OpenZLJNI");
+    if (jni_class == NULL) {
+        scratch_arena_key_delete();
+        release_jni_cache(env);
+        return JNI_ERR;
     }
-    
-    jstring data_type_string = (*env)->NewStringUTF(env, data_type_str);
-    if (data_type_string == NULL) {
-        throw_out_of_memory(env);
-        return NULL;
+    jint registered = (*env)->RegisterNatives(env, jni_class, openzl_jni_methods,
+                                              (jint)(sizeof(openzl_jni_methods) / sizeof(openzl_jni_methods[0])));
+    (*env)->DeleteLocalRef(env, jni_class);
+    if (registered != JNI_OK) {
+        scratch_arena_key_delete();
+        release_jni_cache(env);
+        return JNI_ERR;
     }
     
-    jobject compression_info = (*env)->NewObject(env, compression_info_class, constructor,
-                                                  (jlong)decompressed_size,
-                                                  (jlong)compressed_size,
-                                                  compression_graph,
-                                                  data_type_string);
-    
-    return compression_info;
+    return JNI_VERSION_1_8;
+}
+
+JNIEXPORT void JNICALL
+JNI_OnUnload(JavaVM *vm, void *reserved) {
+    JNIEnv *env;
+    if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_8) == JNI_OK) {
+        release_jni_cache(env);
+    }
+    parallel_runtime_destroy(atomic_exchange(&parallel_runtime, NULL));
+    scratch_arena_key_delete();
 }
\ No newline at end of file
@@ -0,0 +1,348 @@
+// SPDX-License-Identifier: MIT
+// OpenZL JNI Bindings
+// Copyright (c) 2025 Lostlab Technologies
+//
+// Licensed under the MIT License.
+// You may use, modify, and distribute this code freely, provided that this notice is retained.
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "openzl_jni_pool.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+
+typedef HANDLE pool_thread_t;
+typedef SRWLOCK pool_mutex_t;
+typedef CONDITION_VARIABLE pool_cond_t;
+
+static void pool_mutex_init(pool_mutex_t *mutex) { InitializeSRWLock(mutex); }
+static void pool_mutex_destroy(pool_mutex_t *mutex) { (void)mutex; }
+static void pool_mutex_lock(pool_mutex_t *mutex) { AcquireSRWLockExclusive(mutex); }
+static void pool_mutex_unlock(pool_mutex_t *mutex) { ReleaseSRWLockExclusive(mutex); }
+static void pool_cond_init(pool_cond_t *cond) { InitializeConditionVariable(cond); }
+static void pool_cond_destroy(pool_cond_t *cond) { (void)cond; }
+static void pool_cond_wait(pool_cond_t *cond, pool_mutex_t *mutex) { SleepConditionVariableSRW(cond, mutex, INFINITE, 0); }
+static void pool_cond_broadcast(pool_cond_t *cond) { WakeAllConditionVariable(cond); }
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_t pool_thread_t;
+typedef pthread_mutex_t pool_mutex_t;
+typedef pthread_cond_t pool_cond_t;
+
+static void pool_mutex_init(pool_mutex_t *mutex) { pthread_mutex_init(mutex, NULL); }
+static void pool_mutex_destroy(pool_mutex_t *mutex) { pthread_mutex_destroy(mutex); }
+static void pool_mutex_lock(pool_mutex_t *mutex) { pthread_mutex_lock(mutex); }
+static void pool_mutex_unlock(pool_mutex_t *mutex) { pthread_mutex_unlock(mutex); }
+static void pool_cond_init(pool_cond_t *cond) { pthread_cond_init(cond, NULL); }
+static void pool_cond_destroy(pool_cond_t *cond) { pthread_cond_destroy(cond); }
+static void pool_cond_wait(pool_cond_t *cond, pool_mutex_t *mutex) { pthread_cond_wait(cond, mutex); }
+static void pool_cond_broadcast(pool_cond_t *cond) { pthread_cond_broadcast(cond); }
+#endif
+
+#define POOL_CACHE_LINE 64
+
+/**
+ * Chase-Lev deque specialised for a contiguous range of task indices: [top, bottom) is
+ * what is left. The owner pops from the bottom and thieves CAS the top, so no task
+ * buffer is needed. Padded so that neighbouring workers' deques never share a line.
+ */
+typedef struct {
+    atomic_llong top;
+    atomic_llong bottom;
+    char pad[POOL_CACHE_LINE - 2 * sizeof(atomic_llong)];
+} pool_deque_t;
+
+/**
+ * One openzl_pool_run call. Its workers are linked through pool_worker_t.next starting at
+ * first, and are all released together when the last of them finishes, so no member's
+ * deque or link is reused by another job while a member may still steal from it.
+ */
+typedef struct {
+    openzl_pool_task_fn fn;
+    void *job;
+    int first;
+    int participants;
+    int active;
+} pool_job_t;
+
+typedef struct {
+    openzl_pool_t *pool;
+    int id;
+
+    // Guarded by the pool lock. A new job is published by bumping assigned.
+    pool_job_t *job;
+    int next;
+    unsigned long assigned;
+} pool_worker_t;
+
+struct openzl_pool {
+    int size;
+    pool_thread_t *threads;
+    pool_worker_t *workers;
+    pool_deque_t *deques;
+
+    pool_mutex_t lock;
+    pool_cond_t wake;
+    pool_cond_t done;
+
+    // Jobs take workers in ticket order, each once enough of them are idle.
+    int idle;
+    unsigned long next_ticket;
+    unsigned long serving;
+    int shutdown;
+};
+
+static int deque_pop(pool_deque_t *deque, long long *task) {
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return 0;
+    }
+    *task = bottom;
+    if (top < bottom) {
+        return 1;
+    }
+
+    // Last task: race the thieves for it.
+    int won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                      memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return won;
+}
+
+/**
+ * Returns 1 with a stolen task, 0 when the deque is empty.
+ */
+static int deque_steal(pool_deque_t *deque, long long *task) {
+    for (;;) {
+        long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        long long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+        if (top >= bottom) {
+            return 0;
+        }
+        if (atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                    memory_order_seq_cst, memory_order_relaxed)) {
+            *task = top;
+            return 1;
+        }
+    }
+}
+
+static int pool_next_member(const openzl_pool_t *pool, const pool_job_t *job, int id) {
+    int next = pool->workers[id].next;
+    return next < 0 ? job->first : next;
+}
+
+static void pool_work(openzl_pool_t *pool, const pool_job_t *job, int id) {
+    long long task;
+    for (;;) {
+        if (deque_pop(&pool->deques[id], &task)) {
+            job->fn(job->job, (size_t)task, id);
+            continue;
+        }
+
+        int stolen = 0;
+        for (int victim = pool_next_member(pool, job, id); victim != id && !stolen;
+                victim = pool_next_member(pool, job, victim)) {
+            if (deque_steal(&pool->deques[victim], &task)) {
+                job->fn(job->job, (size_t)task, id);
+                stolen = 1;
+            }
+        }
+        if (!stolen) {
+            return;
+        }
+    }
+}
+
+static void pool_worker_loop(pool_worker_t *worker) {
+    openzl_pool_t *pool = worker->pool;
+    unsigned long seen = 0;
+
+    for (;;) {
+        pool_mutex_lock(&pool->lock);
+        while (!pool->shutdown && worker->assigned == seen) {
+            pool_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->shutdown) {
+            pool_mutex_unlock(&pool->lock);
+            return;
+        }
+        seen = worker->assigned;
+        pool_job_t *job = worker->job;
+        pool_mutex_unlock(&pool->lock);
+
+        pool_work(pool, job, worker->id);
+
+        pool_mutex_lock(&pool->lock);
+        if (--job->active == 0) {
+            for (int id = job->first; id >= 0; id = pool->workers[id].next) {
+                pool->workers[id].job = NULL;
+            }
+            pool->idle += job->participants;
+            pool_cond_broadcast(&pool->done);
+        }
+        pool_mutex_unlock(&pool->lock);
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI pool_thread_main(LPVOID arg) {
+    pool_worker_loop(arg);
+    return 0;
+}
+
+static int pool_thread_start(pool_thread_t *thread, pool_worker_t *worker) {
+    *thread = CreateThread(NULL, 0, pool_thread_main, worker, 0, NULL);
+    return *thread == NULL ? -1 : 0;
+}
+
+static void pool_thread_join(pool_thread_t thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+static void *pool_thread_main(void *arg) {
+    pool_worker_loop(arg);
+    return NULL;
+}
+
+static int pool_thread_start(pool_thread_t *thread, pool_worker_t *worker) {
+    return pthread_create(thread, NULL, pool_thread_main, worker) == 0 ? 0 : -1;
+}
+
+static void pool_thread_join(pool_thread_t thread) {
+    pthread_join(thread, NULL);
+}
+#endif
+
+int openzl_hardware_threads(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+static void pool_stop(openzl_pool_t *pool, int started) {
+    pool_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pool_cond_broadcast(&pool->wake);
+    pool_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < started; i++) {
+        pool_thread_join(pool->threads[i]);
+    }
+
+    pool_cond_destroy(&pool->done);
+    pool_cond_destroy(&pool->wake);
+    pool_mutex_destroy(&pool->lock);
+    free(pool->deques);
+    free(pool->workers);
+    free(pool->threads);
+    free(pool);
+}
+
+openzl_pool_t *openzl_pool_create(int threads) {
+    if (threads <= 0) {
+        return NULL;
+    }
+
+    openzl_pool_t *pool = calloc(1, sizeof(openzl_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->size = threads;
+    pool->idle = threads;
+    pool->threads = calloc((size_t)threads, sizeof(pool_thread_t));
+    pool->workers = calloc((size_t)threads, sizeof(pool_worker_t));
+    pool->deques = calloc((size_t)threads, sizeof(pool_deque_t));
+    pool_mutex_init(&pool->lock);
+    pool_cond_init(&pool->wake);
+    pool_cond_init(&pool->done);
+    if (pool->threads == NULL || pool->workers == NULL || pool->deques == NULL) {
+        pool_stop(pool, 0);
+        return NULL;
+    }
+
+    for (int i = 0; i < threads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].id = i;
+        if (pool_thread_start(&pool->threads[i], &pool->workers[i]) != 0) {
+            pool_stop(pool, i);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void openzl_pool_destroy(openzl_pool_t *pool) {
+    if (pool != NULL) {
+        pool_stop(pool, pool->size);
+    }
+}
+
+int openzl_pool_size(const openzl_pool_t *pool) {
+    return pool->size;
+}
+
+void openzl_pool_run(openzl_pool_t *pool, size_t count, int threads, openzl_pool_task_fn fn, void *job) {
+    if (count == 0) {
+        return;
+    }
+    int participants = threads <= 0 || threads > pool->size ? pool->size : threads;
+    if ((size_t)participants > count) {
+        participants = (int)count;
+    }
+
+    pool_job_t run = {fn, job, -1, participants, participants};
+
+    pool_mutex_lock(&pool->lock);
+    unsigned long ticket = pool->next_ticket++;
+    while (pool->serving != ticket || pool->idle < participants) {
+        pool_cond_wait(&pool->done, &pool->lock);
+    }
+
+    int last = -1;
+    for (int id = 0, slot = 0; slot < participants; id++) {
+        pool_worker_t *worker = &pool->workers[id];
+        if (worker->job != NULL) {
+            continue;
+        }
+        size_t start = count * (size_t)slot / (size_t)participants;
+        size_t end = count * (size_t)(slot + 1) / (size_t)participants;
+        atomic_store_explicit(&pool->deques[id].top, (long long)start, memory_order_relaxed);
+        atomic_store_explicit(&pool->deques[id].bottom, (long long)end, memory_order_relaxed);
+        worker->job = &run;
+        worker->next = -1;
+        worker->assigned++;
+        if (last < 0) {
+            run.first = id;
+        } else {
+            pool->workers[last].next = id;
+        }
+        last = id;
+        slot++;
+    }
+    pool->idle -= participants;
+    pool->serving++;
+    pool_cond_broadcast(&pool->wake);
+    pool_cond_broadcast(&pool->done);
+
+    while (run.active > 0) {
+        pool_cond_wait(&pool->done, &pool->lock);
+    }
+    pool_mutex_unlock(&pool->lock);
+}
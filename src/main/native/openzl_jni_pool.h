@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+// OpenZL JNI Bindings
+// Copyright (c) 2025 Lostlab Technologies
+//
+// Licensed under the MIT License.
+// You may use, modify, and distribute this code freely, provided that this notice is retained.
+
+#ifndef OPENZL_JNI_POOL_H
+#define OPENZL_JNI_POOL_H
+
+#include <stddef.h>
+
+/**
+ * Fixed-size native worker pool with one work-stealing deque per worker.
+ *
+ * A job is a range of task indices [0, count). It is split evenly across the participating
+ * workers' deques; each worker drains its own deque from the bottom and then steals from
+ * the top of the others', so uneven tasks still keep every worker busy.
+ *
+ * Concurrent jobs run side by side on disjoint sets of idle workers. They are admitted in
+ * arrival order, each once as many workers as it uses are idle, so a job using the whole
+ * pool still runs alone while jobs capped below the pool size share it. A worker runs one
+ * job at a time, which lets callers keep per-worker state (indexed by the worker
+ * argument) without locking.
+ */
+typedef struct openzl_pool openzl_pool_t;
+
+typedef void (*openzl_pool_task_fn)(void *job, size_t task, int worker);
+
+/**
+ * Starts a pool of the given number of worker threads. Returns NULL on failure.
+ */
+openzl_pool_t *openzl_pool_create(int threads);
+
+/**
+ * Stops and joins all workers, then frees the pool. No job may be running.
+ */
+void openzl_pool_destroy(openzl_pool_t *pool);
+
+int openzl_pool_size(const openzl_pool_t *pool);
+
+/**
+ * Runs fn(job, task, worker) for every task in [0, count) on up to threads workers
+ * (all of them when threads <= 0) and blocks until every task has returned. Waits first
+ * while earlier jobs hold the workers it needs.
+ */
+void openzl_pool_run(openzl_pool_t *pool, size_t count, int threads, openzl_pool_task_fn fn, void *job);
+
+/**
+ * Number of online processors, at least 1.
+ */
+int openzl_hardware_threads(void);
+
+#endif
@@ -0,0 +1,147 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+import static org.junit.jupiter.api.Assumptions.assumeFalse;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.foreign.MemorySegment;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import java.util.stream.Stream;
+import org.junit.jupiter.api.io.TempDir;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.Arguments;
+import org.junit.jupiter.params.provider.EnumSource;
+import org.junit.jupiter.params.provider.MethodSource;
+
+/**
+ * Every API that writes block containers against every API that reads them, so the
+ * writers and readers cannot drift apart from OpenZLFrameFormat.
+ */
+class ContainerReaderTest {
+    
+    interface Codec {
+        byte[] apply(byte[] input, Path dir) throws IOException;
+    }
+    
+    enum Writer {
+        PARALLEL((data, dir) -> TestData.parallel().compress(data)),
+        PIPELINE((data, dir) -> {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            new OpenZLPipeline(CompressionGraph.ZSTD, TestData.BLOCK_SIZE, 2)
+                    .compress(Channels.newChannel(new ByteArrayInputStream(data)), Channels.newChannel(out));
+            return out.toByteArray();
+        }),
+        OUTPUT_STREAM((data, dir) -> {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            try (OpenZLOutputStream stream = new OpenZLOutputStream(out, CompressionGraph.ZSTD, TestData.BLOCK_SIZE)) {
+                stream.write(data);
+            }
+            return out.toByteArray();
+        }),
+        CHANNELS((data, dir) -> {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            try (FileChannel in = FileChannel.open(Files.write(dir.resolve("written.raw"), data))) {
+                OpenZLChannels.compress(in, Channels.newChannel(out), CompressionGraph.ZSTD, TestData.BLOCK_SIZE);
+            }
+            return out.toByteArray();
+        }),
+        FILES((data, dir) -> {
+            Path container = dir.resolve("written.ozlb");
+            OpenZLFiles.compress(Files.write(dir.resolve("written.raw"), data), container,
+                    OpenZLFiles.Options.defaults().withBlockSize(TestData.BLOCK_SIZE));
+            return Files.readAllBytes(container);
+        });
+        
+        final Codec codec;
+        
+        Writer(Codec codec) {
+            this.codec = codec;
+        }
+    }
+    
+    enum Reader {
+        PARALLEL((container, dir) -> TestData.parallel().decompress(container)),
+        PIPELINE((container, dir) -> {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            new OpenZLPipeline(CompressionGraph.ZSTD, TestData.BLOCK_SIZE, 2)
+                    .decompress(Channels.newChannel(new ByteArrayInputStream(container)), Channels.newChannel(out));
+            return out.toByteArray();
+        }),
+        INPUT_STREAM((container, dir) -> {
+            try (InputStream in = new OpenZLInputStream(new ByteArrayInputStream(container))) {
+                return in.readAllBytes();
+            }
+        }),
+        CHANNELS((container, dir) -> {
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            try (FileChannel in = FileChannel.open(Files.write(dir.resolve("read.ozlb"), container))) {
+                OpenZLChannels.decompress(in, Channels.newChannel(out));
+            }
+            return out.toByteArray();
+        }),
+        FILES((container, dir) -> {
+            Path raw = dir.resolve("read.raw");
+            OpenZLFiles.decompress(Files.write(dir.resolve("read.ozlb"), container), raw);
+            return Files.readAllBytes(raw);
+        }),
+        SEEKABLE((container, dir) -> {
+            try (SeekableOpenZLReader reader = new SeekableOpenZLReader(container)) {
+                return reader.read(0, (int) reader.size());
+            }
+        });
+        
+        final Codec codec;
+        
+        Reader(Codec codec) {
+            this.codec = codec;
+        }
+    }
+    
+    @TempDir
+    Path dir;
+    
+    static Stream<Arguments> pairs() {
+        return Arrays.stream(Writer.values()).flatMap(writer -> Arrays.stream(Reader.values())
+                .flatMap(reader -> Stream.of(Arguments.of(writer, reader, 0), Arguments.of(writer, reader, 200_000))));
+    }
+    
+    @ParameterizedTest
+    @MethodSource("pairs")
+    void readsWhatEveryWriterWrites(Writer writer, Reader reader, int size) throws IOException {
+        byte[] data = TestData.sample(size);
+        assertArrayEquals(data, reader.codec.apply(writer.codec.apply(data, dir), dir));
+    }
+    
+    @ParameterizedTest
+    @EnumSource(Reader.class)
+    void rejectsTruncatedContainers(Reader reader) throws IOException {
+        byte[] container = TestData.parallel().compress(TestData.sample(100_000));
+        int end = (int) OpenZLFrameFormat.readBlockTable(MemorySegment.ofArray(container)).frameOffsets[3];
+        for (int length : new int[] {end, container.length / 2, 10}) {
+            byte[] truncated = Arrays.copyOf(container, length);
+            Exception e = assertThrows(Exception.class, () -> reader.codec.apply(truncated, dir));
+            assertTrue(e instanceof IOException || e instanceof OpenZLException, e.toString());
+        }
+    }
+    
+    @ParameterizedTest
+    @EnumSource(Reader.class)
+    void rejectsContainersWithACorruptIndex(Reader reader) throws IOException {
+        assumeFalse(reader == Reader.INPUT_STREAM || reader == Reader.CHANNELS || reader == Reader.PIPELINE,
+                "Streaming readers stop at the end marker and never read the index");
+        assumeFalse(reader == Reader.FILES && TestData.isWindows(), "OpenZLFiles streams on Windows");
+        byte[] container = TestData.parallel().compress(TestData.sample(100_000));
+        OpenZLFrameFormatTest.setIndexEntry(container, 2, 8, Integer.MAX_VALUE);
+        Exception e = assertThrows(Exception.class, () -> reader.codec.apply(container, dir));
+        assertTrue(e instanceof IOException || e instanceof OpenZLException, e.toString());
+    }
+}
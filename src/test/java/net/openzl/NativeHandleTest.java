@@ -0,0 +1,91 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicInteger;
+import org.junit.jupiter.api.Test;
+
+class NativeHandleTest {
+    
+    @Test
+    void destroysOnceAfterTheLastRelease() {
+        AtomicInteger destroyed = new AtomicInteger();
+        NativeHandle handle = new NativeHandle(new Object(), 42, ptr -> destroyed.incrementAndGet(), "Test");
+        assertEquals(42, handle.acquire());
+        handle.acquire();
+        handle.close();
+        assertTrue(handle.isClosed());
+        assertThrows(IllegalStateException.class, handle::acquire);
+        handle.release();
+        assertEquals(0, destroyed.get());
+        handle.release();
+        assertEquals(1, destroyed.get());
+        handle.close();
+        assertEquals(1, destroyed.get());
+    }
+    
+    @Test
+    void closeRacesInFlightCalls() throws Exception {
+        byte[] data = TestData.sample(50_000);
+        ExecutorService executor = Executors.newFixedThreadPool(4);
+        try (OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            for (int round = 0; round < 20; round++) {
+                OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+                CountDownLatch started = new CountDownLatch(4);
+                List<Future<Integer>> workers = new ArrayList<>();
+                for (int i = 0; i < 4; i++) {
+                    workers.add(executor.submit(() -> {
+                        started.countDown();
+                        int completed = 0;
+                        while (true) {
+                            byte[] frame;
+                            try {
+                                frame = compressor.compress(data);
+                            } catch (IllegalStateException e) {
+                                return completed;
+                            }
+                            assertArrayEquals(data, decompressor.decompress(frame));
+                            completed++;
+                        }
+                    }));
+                }
+                started.await();
+                compressor.close();
+                for (Future<Integer> worker : workers) {
+                    worker.get();
+                }
+                assertTrue(compressor.isClosed());
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+    
+    @Test
+    void rejectsCallsAfterClose() {
+        OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+        OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor();
+        byte[] frame = compressor.compress(TestData.sample(1000));
+        compressor.close();
+        decompressor.close();
+        compressor.close();
+        
+        assertThrows(IllegalStateException.class, () -> compressor.compress(new byte[10]));
+        assertThrows(IllegalStateException.class, () -> compressor.compress(ByteBuffer.allocateDirect(10),
+                ByteBuffer.allocateDirect(1000)));
+        assertThrows(IllegalStateException.class, () -> compressor.compressBatch(new byte[][] {new byte[10]}));
+        assertThrows(IllegalStateException.class, () -> compressor.compressInts(new int[10]));
+        assertThrows(IllegalStateException.class, () -> decompressor.decompress(frame));
+        assertThrows(IllegalStateException.class, () -> decompressor.decompressInto(frame, new int[10], 0));
+    }
+}
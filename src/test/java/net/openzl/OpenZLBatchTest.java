@@ -0,0 +1,77 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import org.junit.jupiter.api.Test;
+
+/**
+ * OpenZLCompressor.compressBatch and OpenZLDecompressor.decompressBatch.
+ */
+class OpenZLBatchTest {
+    
+    private static final byte[][] ITEMS = {
+        new byte[0], TestData.sample(1), TestData.sample(100), TestData.sample(70_000), new byte[0],
+    };
+    
+    @Test
+    void roundTripsArrays() {
+        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            OpenZLBatch batch = compressor.compressBatch(ITEMS);
+            assertEquals(ITEMS.length, batch.size());
+            assertArrayEquals(ITEMS, decompressor.decompressBatch(batch));
+            assertArrayEquals(ITEMS[3], decompressor.decompress(batch.getFrame(3)));
+        }
+    }
+    
+    @Test
+    void roundTripsMixedBuffers() {
+        ByteBuffer[] buffers = new ByteBuffer[ITEMS.length];
+        for (int i = 0; i < ITEMS.length; i++) {
+            ByteBuffer buffer = i % 2 == 0 ? ByteBuffer.allocateDirect(ITEMS[i].length + 10)
+                    : ByteBuffer.allocate(ITEMS[i].length + 10);
+            buffer.position(5);
+            buffer.put(ITEMS[i]).flip().position(5);
+            buffers[i] = i == 3 ? buffer.asReadOnlyBuffer() : buffer;
+        }
+        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            OpenZLBatch batch = compressor.compressBatch(buffers);
+            for (ByteBuffer buffer : buffers) {
+                assertEquals(buffer.limit(), buffer.position());
+            }
+            assertArrayEquals(ITEMS, decompressor.decompressBatch(batch));
+        }
+    }
+    
+    @Test
+    void rejectsMalformedOffsets() {
+        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            OpenZLBatch batch = compressor.compressBatch(ITEMS);
+            byte[] data = batch.getData();
+            int[] offsets = batch.getOffsets();
+            
+            int[] decreasing = offsets.clone();
+            decreasing[2] = decreasing[3] + 1;
+            int[] pastTheEnd = offsets.clone();
+            pastTheEnd[pastTheEnd.length - 1] = data.length + 1;
+            int[] negative = offsets.clone();
+            negative[0] = -1;
+            for (int[] bad : new int[][] {decreasing, pastTheEnd, negative}) {
+                assertThrows(IndexOutOfBoundsException.class, () -> decompressor.decompressBatch(data, bad));
+                assertThrows(IndexOutOfBoundsException.class, () -> new OpenZLBatch(data, bad));
+            }
+            assertThrows(IllegalArgumentException.class, () -> decompressor.decompressBatch(data, new int[0]));
+            
+            int[] misaligned = offsets.clone();
+            misaligned[4] = misaligned[3] + 1;
+            assertThrows(OpenZLException.class, () -> decompressor.decompressBatch(data, misaligned));
+            assertArrayEquals(new byte[0][], decompressor.decompressBatch(data, Arrays.copyOf(offsets, 1)));
+        }
+    }
+}
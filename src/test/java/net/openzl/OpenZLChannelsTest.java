@@ -0,0 +1,50 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+class OpenZLChannelsTest {
+    
+    @TempDir
+    Path dir;
+    
+    @Test
+    void compressesFromThePosition() throws IOException {
+        byte[] data = TestData.sample(100_000);
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        try (FileChannel in = FileChannel.open(Files.write(dir.resolve("data.raw"), data))) {
+            in.position(1000);
+            long written = OpenZLChannels.compress(in, Channels.newChannel(out), CompressionGraph.ZSTD,
+                    TestData.BLOCK_SIZE);
+            assertEquals(out.size(), written);
+            assertEquals(data.length, in.position());
+        }
+        assertArrayEquals(Arrays.copyOfRange(data, 1000, data.length), TestData.parallel().decompress(out.toByteArray()));
+    }
+    
+    @Test
+    void decompressesFromThePosition() throws IOException {
+        byte[] data = TestData.sample(100_000);
+        byte[] container = TestData.parallel().compress(data);
+        byte[] file = new byte[1000 + container.length];
+        System.arraycopy(container, 0, file, 1000, container.length);
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        try (FileChannel in = FileChannel.open(Files.write(dir.resolve("data.ozlb"), file))) {
+            in.position(1000);
+            long written = OpenZLChannels.decompress(in, Channels.newChannel(out));
+            assertEquals(data.length, written);
+            assertEquals(file.length, in.position());
+        }
+        assertArrayEquals(data, out.toByteArray());
+    }
+}
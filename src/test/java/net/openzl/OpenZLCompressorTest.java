@@ -0,0 +1,106 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.EnumSource;
+
+/**
+ * Buffer and array calls of OpenZLCompressor and OpenZLDecompressor on each backend.
+ */
+class OpenZLCompressorTest {
+    
+    private final OpenZLBackend initialBackend = OpenZLFactory.getBackend();
+    
+    @AfterEach
+    void restoreDefaults() {
+        OpenZLFactory.setBackend(initialBackend);
+        OpenZLFactory.setCriticalArrayThreshold(Integer.getInteger("openzl.criticalArrayThreshold", 256 * 1024));
+    }
+    
+    @ParameterizedTest
+    @EnumSource(OpenZLBackend.class)
+    void advancesDirectBufferPositions(OpenZLBackend backend) {
+        OpenZLFactory.setBackend(backend);
+        byte[] data = TestData.sample(100_000);
+        ByteBuffer src = ByteBuffer.allocateDirect(data.length + 300);
+        src.position(100);
+        src.put(data).limit(100 + data.length).position(100);
+        ByteBuffer frame = ByteBuffer.allocateDirect(OpenZLCompressor.maxCompressedLength(data.length) + 300);
+        frame.position(200).limit(frame.capacity() - 50);
+        ByteBuffer restored = ByteBuffer.allocateDirect(data.length + 300);
+        restored.position(50).limit(50 + data.length + 10);
+        
+        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            int compressed = compressor.compress(src, frame);
+            assertEquals(src.limit(), src.position());
+            assertEquals(100 + data.length, src.limit());
+            assertEquals(200 + compressed, frame.position());
+            assertEquals(frame.capacity() - 50, frame.limit());
+            
+            frame.limit(frame.position()).position(200);
+            int decompressed = decompressor.decompress(frame, restored);
+            assertEquals(data.length, decompressed);
+            assertEquals(frame.limit(), frame.position());
+            assertEquals(50 + data.length, restored.position());
+            assertEquals(50 + data.length + 10, restored.limit());
+        }
+        byte[] actual = new byte[data.length];
+        restored.position(50).get(actual);
+        assertArrayEquals(data, actual);
+    }
+    
+    /**
+     * 0 copies every array and MAX_VALUE pins every one, so both paths see the same slices.
+     */
+    @ParameterizedTest
+    @EnumSource(OpenZLBackend.class)
+    void matchesAcrossTheCriticalThreshold(OpenZLBackend backend) {
+        OpenZLFactory.setBackend(backend);
+        byte[] data = TestData.sample(100_000);
+        byte[][] frames = new byte[2][];
+        int[] thresholds = {0, Integer.MAX_VALUE};
+        for (int t = 0; t < thresholds.length; t++) {
+            OpenZLFactory.setCriticalArrayThreshold(thresholds[t]);
+            try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+                 OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+                byte[] frame = new byte[OpenZLCompressor.maxCompressedLength(data.length - 1000) + 20];
+                int compressed = compressor.compress(data, 1000, data.length - 1000, frame, 10, frame.length - 20);
+                frames[t] = Arrays.copyOfRange(frame, 10, 10 + compressed);
+                
+                byte[] restored = new byte[data.length + 20];
+                int decompressed = decompressor.decompress(frame, 10, compressed, restored, 7, data.length);
+                assertEquals(data.length - 1000, decompressed);
+                assertArrayEquals(Arrays.copyOfRange(data, 1000, data.length),
+                        Arrays.copyOfRange(restored, 7, 7 + decompressed));
+                assertEquals(0, restored[6]);
+                assertEquals(0, restored[7 + decompressed]);
+            }
+        }
+        assertArrayEquals(frames[0], frames[1]);
+    }
+    
+    @ParameterizedTest
+    @EnumSource(OpenZLBackend.class)
+    void rejectsRangesThatOverflow(OpenZLBackend backend) {
+        OpenZLFactory.setBackend(backend);
+        byte[] data = new byte[100];
+        byte[] frame = new byte[1000];
+        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor();
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            assertThrows(IndexOutOfBoundsException.class, () -> compressor.compress(data, Integer.MAX_VALUE, 10));
+            assertThrows(IndexOutOfBoundsException.class, () -> compressor.compress(data, 10, Integer.MAX_VALUE));
+            assertThrows(IndexOutOfBoundsException.class,
+                    () -> compressor.compress(data, 0, 100, frame, Integer.MAX_VALUE, 10));
+            assertThrows(IndexOutOfBoundsException.class, () -> decompressor.decompress(frame, Integer.MAX_VALUE, 10));
+            assertThrows(IndexOutOfBoundsException.class,
+                    () -> decompressor.decompress(frame, 0, 10, data, Integer.MAX_VALUE, 10));
+        }
+    }
+}
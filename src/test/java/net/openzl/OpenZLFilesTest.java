@@ -0,0 +1,106 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assumptions.abort;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+class OpenZLFilesTest {
+    
+    @TempDir
+    Path dir;
+    
+    @Test
+    void roundTripsWithDefaults() throws IOException {
+        roundTrip(dir, OpenZLFiles.Options.defaults(), 300_000);
+    }
+    
+    @Test
+    void roundTripsSerially() throws IOException {
+        roundTrip(dir, OpenZLFiles.Options.defaults().withBlockSize(TestData.BLOCK_SIZE).withThreads(1), 300_000);
+    }
+    
+    @Test
+    void roundTripsAcrossRounds() throws IOException {
+        OpenZLFiles.Options options = OpenZLFiles.Options.defaults().withBlockSize(TestData.BLOCK_SIZE)
+                .withThreads(2).withDropCache(true);
+        roundTrip(dir, options, 2_000_000);
+    }
+    
+    @Test
+    void roundTripsWithIoUring() throws IOException {
+        assumeTrue(OpenZLFiles.isIoUringAvailable(), "io_uring is not available");
+        roundTrip(dir, OpenZLFiles.Options.defaults().withBlockSize(TestData.BLOCK_SIZE).withIoUring(true), 2_000_000);
+    }
+    
+    @Test
+    void roundTripsEmptyFiles() throws IOException {
+        roundTrip(dir, OpenZLFiles.Options.defaults(), 0);
+    }
+    
+    @Test
+    void refusesToOverwriteTheSource() throws IOException {
+        byte[] data = TestData.sample(100_000);
+        Path raw = Files.write(dir.resolve("data.raw"), data);
+        assertThrows(IOException.class, () -> OpenZLFiles.compress(raw, raw));
+        assertThrows(IOException.class, () -> OpenZLFiles.compress(raw, dir.resolve(".").resolve("data.raw")));
+        assertThrows(IOException.class, () -> OpenZLFiles.decompress(raw, raw));
+        assertArrayEquals(data, Files.readAllBytes(raw));
+    }
+    
+    @Test
+    void parallelRefusesToOverwriteTheSource() throws IOException {
+        byte[] container = TestData.parallel().compress(TestData.sample(100_000));
+        Path src = Files.write(dir.resolve("data.ozlb"), container);
+        assertThrows(IOException.class, () -> TestData.parallel().decompress(src, src));
+        assertArrayEquals(container, Files.readAllBytes(src));
+        
+        Path truncated = Files.write(dir.resolve("truncated.ozlb"), Arrays.copyOf(container, container.length / 2));
+        Path restored = dir.resolve("restored.raw");
+        assertThrows(Exception.class, () -> TestData.parallel().decompress(truncated, restored));
+        assertFalse(Files.exists(restored));
+    }
+    
+    @Test
+    void refusesToOverwriteTheSourceThroughALink() throws IOException {
+        byte[] data = TestData.sample(100_000);
+        Path raw = Files.write(dir.resolve("data.raw"), data);
+        Path link = dir.resolve("link.raw");
+        try {
+            Files.createLink(link, raw);
+        } catch (UnsupportedOperationException e) {
+            abort("Hard links are not supported");
+        }
+        assertThrows(IOException.class, () -> OpenZLFiles.compress(raw, link));
+        assertArrayEquals(data, Files.readAllBytes(raw));
+    }
+    
+    @Test
+    void removesPartialOutputOnFailure() throws IOException {
+        byte[] container = TestData.parallel().compress(TestData.sample(100_000));
+        Path truncated = Files.write(dir.resolve("truncated.ozlb"), Arrays.copyOf(container, container.length / 2));
+        Path restored = Files.write(dir.resolve("restored.raw"), new byte[] {1, 2, 3});
+        assertThrows(Exception.class, () -> OpenZLFiles.decompress(truncated, restored));
+        assertFalse(Files.exists(restored));
+    }
+    
+    static void roundTrip(Path dir, OpenZLFiles.Options options, int size) throws IOException {
+        byte[] data = TestData.sample(size);
+        Path raw = Files.write(dir.resolve("data.raw"), data);
+        Path container = dir.resolve("data.ozlb");
+        Path restored = dir.resolve("restored.raw");
+        long written = OpenZLFiles.compress(raw, container, options);
+        assertEquals(Files.size(container), written);
+        assertEquals(size, OpenZLFiles.decompress(container, restored, options));
+        assertArrayEquals(data, Files.readAllBytes(restored));
+    }
+}
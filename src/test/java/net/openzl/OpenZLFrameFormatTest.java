@@ -0,0 +1,170 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assumptions.assumeFalse;
+
+import java.io.IOException;
+import java.lang.foreign.MemorySegment;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+/**
+ * The Java reader (OpenZLFrameFormat.readBlockTable) and the native one behind
+ * OpenZLFiles.decompress must accept and reject exactly the same containers.
+ */
+class OpenZLFrameFormatTest {
+    
+    private static final byte[] DATA = TestData.sample(100_000);
+    
+    @TempDir
+    Path dir;
+    
+    @Test
+    void readsIndexedContainers() throws IOException {
+        byte[] container = TestData.parallel().compress(DATA);
+        OpenZLFrameFormat.BlockTable table = OpenZLFrameFormat.readBlockTable(MemorySegment.ofArray(container));
+        assertEquals(7, table.count);
+        assertEquals(DATA.length, table.rawSize);
+        assertBothAccept(container);
+    }
+    
+    @Test
+    void readsUnindexedContainers() throws IOException {
+        byte[] container = unindexed(TestData.parallel().compress(DATA));
+        OpenZLFrameFormat.BlockTable table = OpenZLFrameFormat.readBlockTable(MemorySegment.ofArray(container));
+        assertEquals(7, table.count);
+        assertEquals(container.length, table.containerSize);
+        assertBothAccept(container);
+    }
+    
+    @Test
+    void rejectsIndexedContainersWithoutTrailerMagic() throws IOException {
+        byte[] container = TestData.parallel().compress(DATA);
+        MemorySegment.ofArray(container).set(OpenZLFrameFormat.INT, container.length - 4, 0);
+        assertBothReject(container);
+    }
+    
+    @Test
+    void rejectsIndexedContainersWithoutTrailer() throws IOException {
+        assertBothReject(unindexed(TestData.parallel().compress(DATA), true));
+    }
+    
+    @Test
+    void rejectsMisplacedIndexes() throws IOException {
+        byte[] container = TestData.parallel().compress(DATA);
+        MemorySegment segment = MemorySegment.ofArray(container);
+        long trailer = container.length - OpenZLFrameFormat.TRAILER_SIZE;
+        segment.set(OpenZLFrameFormat.LONG, trailer, segment.get(OpenZLFrameFormat.LONG, trailer) + 1);
+        assertBothReject(container);
+        
+        container = TestData.parallel().compress(DATA);
+        segment = MemorySegment.ofArray(container);
+        segment.set(OpenZLFrameFormat.INT, trailer + 8, 8);
+        assertBothReject(container);
+    }
+    
+    @Test
+    void rejectsIndexEntriesOutOfBounds() throws IOException {
+        byte[] container = TestData.parallel().compress(DATA);
+        setIndexEntry(container, 6, 8, Integer.MAX_VALUE);
+        assertBothReject(container);
+        
+        container = TestData.parallel().compress(DATA);
+        setIndexEntry(container, 0, 8, 0);
+        assertBothReject(container);
+        
+        container = TestData.parallel().compress(DATA);
+        long indexOffset = indexOffset(container);
+        MemorySegment.ofArray(container).set(OpenZLFrameFormat.LONG, indexOffset + 6 * OpenZLFrameFormat.INDEX_ENTRY_SIZE,
+                indexOffset);
+        assertBothReject(container);
+    }
+    
+    @Test
+    void rejectsIndexedRawSizesAboveTheBlockSize() throws IOException {
+        byte[] container = TestData.parallel().compress(DATA);
+        setIndexEntry(container, 2, 12, TestData.BLOCK_SIZE + 1);
+        assertBothReject(container);
+    }
+    
+    @Test
+    void rejectsWalkedRawSizesAboveTheBlockSize() throws IOException {
+        byte[] container = unindexed(TestData.parallel().compress(DATA));
+        long frame = OpenZLFrameFormat.readBlockTable(MemorySegment.ofArray(container)).frameOffsets[2];
+        MemorySegment.ofArray(container).set(OpenZLFrameFormat.INT, frame - 4, TestData.BLOCK_SIZE + 1);
+        assertBothReject(container);
+    }
+    
+    @Test
+    void rejectsInvalidBlockSizes() throws IOException {
+        byte[] container = TestData.parallel().compress(DATA);
+        MemorySegment.ofArray(container).set(OpenZLFrameFormat.INT, 8, OpenZLFrameFormat.MIN_BLOCK_SIZE - 1);
+        assertBothReject(container);
+    }
+    
+    @Test
+    void rejectsTruncatedContainers() throws IOException {
+        byte[] indexed = TestData.parallel().compress(DATA);
+        for (int length : new int[] {indexed.length - 1, indexed.length - OpenZLFrameFormat.TRAILER_SIZE, 40,
+                OpenZLFrameFormat.HEADER_SIZE + 2}) {
+            assertBothReject(Arrays.copyOf(indexed, length));
+        }
+        
+        byte[] walked = unindexed(indexed);
+        for (int length : new int[] {walked.length - 1, walked.length - 100, OpenZLFrameFormat.HEADER_SIZE + 6}) {
+            assertBothReject(Arrays.copyOf(walked, length));
+        }
+    }
+    
+    /**
+     * The same container without its index: flag cleared and cut after the end marker.
+     */
+    static byte[] unindexed(byte[] container) {
+        return unindexed(container, false);
+    }
+    
+    /**
+     * keepFlag leaves FLAG_INDEXED set, giving a container that claims an index it lacks.
+     */
+    static byte[] unindexed(byte[] container, boolean keepFlag) {
+        OpenZLFrameFormat.BlockTable table = OpenZLFrameFormat.readBlockTable(MemorySegment.ofArray(container));
+        int last = table.count - 1;
+        long end = table.frameOffsets[last] + table.compressedSizes[last] + OpenZLFrameFormat.END_MARKER_SIZE;
+        byte[] copy = Arrays.copyOf(container, (int) end);
+        if (!keepFlag) {
+            copy[5] = 0;
+        }
+        return copy;
+    }
+    
+    static long indexOffset(byte[] container) {
+        return MemorySegment.ofArray(container).get(OpenZLFrameFormat.LONG,
+                container.length - OpenZLFrameFormat.TRAILER_SIZE);
+    }
+    
+    static void setIndexEntry(byte[] container, int block, int field, int value) {
+        MemorySegment.ofArray(container).set(OpenZLFrameFormat.INT,
+                indexOffset(container) + (long) block * OpenZLFrameFormat.INDEX_ENTRY_SIZE + field, value);
+    }
+    
+    private void assertBothAccept(byte[] container) throws IOException {
+        assertArrayEquals(DATA, TestData.parallel().decompress(container));
+        assumeFalse(TestData.isWindows(), "No native file support");
+        Path src = Files.write(dir.resolve("valid.ozlb"), container);
+        Path dest = dir.resolve("valid.raw");
+        assertEquals(DATA.length, OpenZLFiles.decompress(src, dest));
+        assertArrayEquals(DATA, Files.readAllBytes(dest));
+    }
+    
+    private void assertBothReject(byte[] container) throws IOException {
+        assertThrows(OpenZLException.class, () -> OpenZLFrameFormat.readBlockTable(MemorySegment.ofArray(container)));
+        assumeFalse(TestData.isWindows(), "No native file support");
+        Path src = Files.write(dir.resolve("corrupt.ozlb"), container);
+        assertThrows(OpenZLException.class, () -> OpenZLFiles.decompress(src, dir.resolve("corrupt.raw")));
+    }
+}
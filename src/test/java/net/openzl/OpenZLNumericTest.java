@@ -0,0 +1,125 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+import java.util.Arrays;
+import java.util.Random;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+/**
+ * The numeric compress and decompress methods of OpenZLCompressor and OpenZLDecompressor.
+ */
+class OpenZLNumericTest {
+    
+    private static final int COUNT = 10_000;
+    
+    @ParameterizedTest
+    @ValueSource(ints = {1, 2, 4, 8})
+    void roundTripsEveryWidth(int elementSize) {
+        byte[] data = packed(elementSize, COUNT);
+        try (OpenZLCompressor compressor = OpenZLFactory.compressor(CompressionGraph.NUMERIC);
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            byte[] frame = compressor.compressNumeric(data, elementSize, COUNT);
+            assertArrayEquals(data, decompressor.decompressNumeric(frame, elementSize, COUNT));
+        }
+    }
+    
+    @Test
+    void rejectsBadWidths() {
+        byte[] data = packed(4, COUNT);
+        try (OpenZLCompressor compressor = OpenZLFactory.compressor(CompressionGraph.NUMERIC);
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressNumeric(data, 3, data.length / 3));
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressNumeric(data, 16, data.length / 16));
+            byte[] frame = compressor.compressNumeric(data, 4, COUNT);
+            assertThrows(IllegalArgumentException.class, () -> decompressor.decompressNumeric(frame, 3, COUNT));
+            assertThrows(OpenZLException.class, () -> decompressor.decompressNumeric(frame, 8, COUNT / 2));
+        }
+    }
+    
+    @Test
+    void rejectsLengthMismatches() {
+        byte[] data = packed(4, COUNT);
+        try (OpenZLCompressor compressor = OpenZLFactory.compressor(CompressionGraph.NUMERIC);
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressNumeric(data, 4, COUNT + 1));
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressNumeric(data, 8, COUNT));
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressNumeric(data, 4, 0));
+            byte[] frame = compressor.compressNumeric(data, 4, COUNT);
+            assertThrows(OpenZLException.class, () -> decompressor.decompressNumeric(frame, 4, COUNT - 1));
+            assertThrows(OpenZLException.class, () -> decompressor.decompressNumeric(frame, 4, COUNT + 1));
+        }
+    }
+    
+    @Test
+    void decompressesIntoArraysAtAnOffset() {
+        int[] ints = new int[COUNT];
+        long[] longs = new long[COUNT];
+        float[] floats = new float[COUNT];
+        double[] doubles = new double[COUNT];
+        for (int i = 0; i < COUNT; i++) {
+            ints[i] = i * 7;
+            longs[i] = i * 7L << 20;
+            floats[i] = i * 0.5f;
+            doubles[i] = i * 0.25;
+        }
+        try (OpenZLCompressor compressor = OpenZLFactory.compressor(CompressionGraph.NUMERIC);
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            int[] intDest = new int[COUNT + 5];
+            assertEquals(COUNT, decompressor.decompressInto(compressor.compressInts(ints), intDest, 5));
+            assertArrayEquals(ints, Arrays.copyOfRange(intDest, 5, COUNT + 5));
+            
+            long[] longDest = new long[COUNT + 5];
+            assertEquals(COUNT, decompressor.decompressInto(compressor.compressLongs(longs), longDest, 5));
+            assertArrayEquals(longs, Arrays.copyOfRange(longDest, 5, COUNT + 5));
+            
+            float[] floatDest = new float[COUNT + 5];
+            assertEquals(COUNT, decompressor.decompressInto(compressor.compressFloats(floats), floatDest, 5));
+            assertArrayEquals(floats, Arrays.copyOfRange(floatDest, 5, COUNT + 5));
+            
+            double[] doubleDest = new double[COUNT + 5];
+            assertEquals(COUNT, decompressor.decompressInto(compressor.compressDoubles(doubles), doubleDest, 5));
+            assertArrayEquals(doubles, Arrays.copyOfRange(doubleDest, 5, COUNT + 5));
+        }
+    }
+    
+    @Test
+    void rejectsWrongWidthsAndShortDestinations() {
+        try (OpenZLCompressor compressor = OpenZLFactory.compressor(CompressionGraph.NUMERIC);
+             OpenZLDecompressor decompressor = OpenZLFactory.fastDecompressor()) {
+            byte[] intFrame = compressor.compressInts(new int[COUNT]);
+            byte[] longFrame = compressor.compressLongs(new long[COUNT]);
+            assertThrows(OpenZLException.class, () -> decompressor.decompressInto(intFrame, new long[COUNT], 0));
+            assertThrows(OpenZLException.class, () -> decompressor.decompressInto(intFrame, new double[COUNT], 0));
+            assertThrows(OpenZLException.class, () -> decompressor.decompressInto(longFrame, new int[2 * COUNT], 0));
+            assertThrows(OpenZLException.class, () -> decompressor.decompressInto(longFrame, new float[2 * COUNT], 0));
+            
+            assertThrows(OpenZLException.class, () -> decompressor.decompressInto(intFrame, new int[COUNT - 1], 0));
+            assertThrows(OpenZLException.class, () -> decompressor.decompressInto(intFrame, new int[COUNT], 1));
+            assertThrows(OpenZLException.class, () -> decompressor.decompressInto(longFrame, new long[COUNT], 1));
+            assertThrows(IndexOutOfBoundsException.class,
+                    () -> decompressor.decompressInto(intFrame, new int[COUNT], COUNT + 1));
+            assertThrows(IndexOutOfBoundsException.class,
+                    () -> decompressor.decompressInto(intFrame, new int[COUNT], -1));
+        }
+    }
+    
+    /**
+     * A noisy little-endian ramp of count elements, each elementSize bytes wide.
+     */
+    static byte[] packed(int elementSize, int count) {
+        Random random = new Random(elementSize);
+        byte[] data = new byte[elementSize * count];
+        for (int i = 0; i < count; i++) {
+            long value = i * 3L + random.nextInt(4);
+            for (int b = 0; b < elementSize; b++) {
+                data[i * elementSize + b] = (byte) (value >>> (8 * b));
+            }
+        }
+        return data;
+    }
+}
@@ -0,0 +1,71 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+class OpenZLParallelTest {
+    
+    @Test
+    void roundTripsByteArrays() {
+        byte[] data = TestData.sample(300_000);
+        byte[] container = TestData.parallel().compress(data);
+        assertTrue(OpenZLParallel.isContainer(container));
+        assertEquals(19, OpenZLFrameFormat.readBlockTable(MemorySegment.ofArray(container)).count);
+        assertArrayEquals(data, TestData.parallel().decompress(container));
+    }
+    
+    @Test
+    void roundTripsSlices() {
+        byte[] data = TestData.sample(300_000);
+        byte[] container = TestData.parallel().compress(data, 1000, 200_000);
+        assertArrayEquals(Arrays.copyOfRange(data, 1000, 201_000), TestData.parallel().decompress(container));
+    }
+    
+    @Test
+    void roundTripsNativeSegments() {
+        byte[] data = TestData.sample(300_000);
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment src = arena.allocate(data.length).copyFrom(MemorySegment.ofArray(data));
+            MemorySegment container = TestData.parallel().compress(src, arena);
+            MemorySegment decoded = TestData.parallel().decompress(container, arena);
+            assertArrayEquals(data, decoded.toArray(ValueLayout.JAVA_BYTE));
+            assertArrayEquals(data, TestData.parallel().decompress(container.toArray(ValueLayout.JAVA_BYTE)));
+        }
+    }
+    
+    @Test
+    void decompressesFrameRuns() {
+        byte[] first = TestData.sample(50_000);
+        byte[] second = TestData.sample(70_000);
+        ByteArrayOutputStream frames = new ByteArrayOutputStream();
+        try (OpenZLCompressor compressor = OpenZLFactory.fastCompressor()) {
+            frames.writeBytes(compressor.compress(first));
+            frames.writeBytes(compressor.compress(second));
+        }
+        ByteArrayOutputStream expected = new ByteArrayOutputStream();
+        expected.writeBytes(first);
+        expected.writeBytes(second);
+        assertArrayEquals(expected.toByteArray(), TestData.parallel().decompress(frames.toByteArray()));
+    }
+    
+    @Test
+    void decompressesFiles(@TempDir Path dir) throws IOException {
+        byte[] data = TestData.sample(300_000);
+        Path src = Files.write(dir.resolve("data.ozlb"), TestData.parallel().compress(data));
+        Path dest = dir.resolve("data.raw");
+        assertEquals(data.length, TestData.parallel().decompress(src, dest));
+        assertArrayEquals(data, Files.readAllBytes(dest));
+    }
+}
@@ -0,0 +1,58 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.channels.Channels;
+import org.junit.jupiter.api.Test;
+
+class OpenZLPipelineTest {
+    
+    @Test
+    void roundTripsWithAnyWorkerCount() throws IOException {
+        byte[] data = TestData.sample(500_000);
+        for (int workers : new int[] {1, 4}) {
+            OpenZLPipeline pipeline = new OpenZLPipeline(CompressionGraph.ZSTD, TestData.BLOCK_SIZE, workers);
+            assertArrayEquals(data, decompress(pipeline, compress(pipeline, data)));
+        }
+    }
+    
+    @Test
+    void reportsWriteFailures() {
+        OpenZLPipeline pipeline = new OpenZLPipeline(CompressionGraph.ZSTD, TestData.BLOCK_SIZE, 2);
+        OutputStream broken = new OutputStream() {
+            @Override
+            public void write(int b) throws IOException {
+                throw new IOException("broken");
+            }
+            
+            @Override
+            public void write(byte[] b, int off, int len) throws IOException {
+                throw new IOException("broken");
+            }
+        };
+        IOException e = assertThrows(IOException.class, () -> pipeline.compress(
+                Channels.newChannel(new ByteArrayInputStream(TestData.sample(500_000))), Channels.newChannel(broken)));
+        assertEquals("broken", e.getMessage());
+    }
+    
+    static byte[] compress(OpenZLPipeline pipeline, byte[] data) throws IOException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        long written = pipeline.compress(Channels.newChannel(new ByteArrayInputStream(data)), Channels.newChannel(out));
+        assertEquals(out.size(), written);
+        return out.toByteArray();
+    }
+    
+    static byte[] decompress(OpenZLPipeline pipeline, byte[] container) throws IOException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        long written = pipeline.decompress(Channels.newChannel(new ByteArrayInputStream(container)),
+                Channels.newChannel(out));
+        assertEquals(out.size(), written);
+        return out.toByteArray();
+    }
+}
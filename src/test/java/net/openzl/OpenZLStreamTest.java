@@ -0,0 +1,65 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.Arrays;
+import org.junit.jupiter.api.Test;
+
+/**
+ * OpenZLOutputStream and OpenZLInputStream.
+ */
+class OpenZLStreamTest {
+    
+    @Test
+    void roundTripsUnevenWritesAndFlushes() throws IOException {
+        byte[] data = TestData.sample(300_000);
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        try (OpenZLOutputStream out = new OpenZLOutputStream(sink, CompressionGraph.ZSTD, TestData.BLOCK_SIZE)) {
+            int pos = 0;
+            for (int step = 1; pos < data.length; step = step * 3 % 40_000 + 1) {
+                int n = Math.min(step, data.length - pos);
+                out.write(data, pos, n);
+                pos += n;
+                if (step % 7 == 0) {
+                    out.flush();
+                }
+            }
+            out.write(7);
+            out.finish();
+            assertEquals(sink.size(), out.getCompressedSize());
+        }
+        byte[] expected = Arrays.copyOf(data, data.length + 1);
+        expected[data.length] = 7;
+        try (InputStream in = new OpenZLInputStream(new ByteArrayInputStream(sink.toByteArray()))) {
+            assertArrayEquals(expected, in.readAllBytes());
+        }
+    }
+    
+    @Test
+    void readsSingleBytes() throws IOException {
+        byte[] data = TestData.sample(40_000);
+        try (InputStream in = new OpenZLInputStream(new ByteArrayInputStream(TestData.parallel().compress(data)))) {
+            for (byte b : data) {
+                assertEquals(b & 0xFF, in.read());
+            }
+            assertEquals(-1, in.read());
+        }
+    }
+    
+    @Test
+    void rejectsWritesAfterFinish() throws IOException {
+        OpenZLOutputStream out = new OpenZLOutputStream(new ByteArrayOutputStream(), CompressionGraph.ZSTD,
+                TestData.BLOCK_SIZE);
+        out.finish();
+        assertThrows(IOException.class, () -> out.write(1));
+        out.close();
+        out.close();
+        assertThrows(IOException.class, () -> out.write(new byte[10]));
+    }
+}
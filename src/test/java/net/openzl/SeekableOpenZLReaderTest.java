@@ -0,0 +1,66 @@
+package net.openzl;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+class SeekableOpenZLReaderTest {
+    
+    @Test
+    void closeRacesReadsOfAMappedFile(@TempDir Path dir) throws Exception {
+        byte[] data = TestData.sample(300_000);
+        Path container = Files.write(dir.resolve("data.ozlb"), TestData.parallel().compress(data));
+        ExecutorService executor = Executors.newFixedThreadPool(4);
+        try {
+            for (int round = 0; round < 20; round++) {
+                SeekableOpenZLReader reader = SeekableOpenZLReader.open(container);
+                CountDownLatch started = new CountDownLatch(4);
+                List<Future<?>> readers = new ArrayList<>();
+                for (int i = 0; i < 4; i++) {
+                    int offset = i * 50_000 + 1000;
+                    readers.add(executor.submit(() -> {
+                        started.countDown();
+                        while (true) {
+                            byte[] read;
+                            try {
+                                read = reader.read(offset, 40_000);
+                            } catch (IllegalStateException e) {
+                                return null;
+                            }
+                            assertArrayEquals(Arrays.copyOfRange(data, offset, offset + 40_000), read);
+                        }
+                    }));
+                }
+                started.await();
+                reader.close();
+                for (Future<?> future : readers) {
+                    future.get();
+                }
+                assertThrows(IllegalStateException.class, () -> reader.read(0, 10));
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+    
+    @Test
+    void closesIdempotently(@TempDir Path dir) throws IOException {
+        Path container = Files.write(dir.resolve("data.ozlb"), TestData.parallel().compress(TestData.sample(1000)));
+        SeekableOpenZLReader reader = SeekableOpenZLReader.open(container);
+        reader.close();
+        reader.close();
+        assertThrows(IllegalStateException.class, () -> reader.read(0, new byte[10], 0, 10));
+    }
+}
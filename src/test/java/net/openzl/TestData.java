@@ -0,0 +1,47 @@
+package net.openzl;
+
+import java.util.Locale;
+import java.util.Random;
+import java.util.concurrent.ForkJoinPool;
+
+/**
+ * Shared inputs for the round-trip tests.
+ */
+final class TestData {
+    
+    /**
+     * Small enough that a few hundred KB span many blocks.
+     */
+    static final int BLOCK_SIZE = 16 * 1024;
+    
+    private static final String[] WORDS = {
+        "openzl", "block", "frame", "container", "index", "trailer", "pipeline", "channel",
+    };
+    
+    private TestData() {
+    }
+    
+    /**
+     * Deterministic, moderately compressible text of exactly size bytes.
+     */
+    static byte[] sample(int size) {
+        Random random = new Random(size);
+        byte[] data = new byte[size];
+        int pos = 0;
+        while (pos < size) {
+            byte[] word = (WORDS[random.nextInt(WORDS.length)] + random.nextInt(1000) + ' ').getBytes();
+            int n = Math.min(word.length, size - pos);
+            System.arraycopy(word, 0, data, pos, n);
+            pos += n;
+        }
+        return data;
+    }
+    
+    static OpenZLParallel parallel() {
+        return new OpenZLParallel(CompressionGraph.ZSTD, BLOCK_SIZE, ForkJoinPool.commonPool());
+    }
+    
+    static boolean isWindows() {
+        return System.getProperty("os.name", "").toLowerCase(Locale.ROOT).startsWith("windows");
+    }
+}